@@ -1,26 +1,144 @@
+// 液晶コントローラ（コンパイル時に選択）
+#define LCD_ILI9341 0 // ILI9341 240x320
+#define LCD_ST7789 1 // ST7789 240x240または240x320
+#define LCD_ILI9488 2 // ILI9488 320x480（SPIでは18ビットカラーのみ）
+#ifndef LCD_CONTROLLER
+#define LCD_CONTROLLER LCD_ILI9341
+#endif
+
+// パネルの縦置き時の解像度（LCD_HEIGHT）とコントローラ内蔵メモリの行数（LCD_GRAMH）
+#if LCD_CONTROLLER == LCD_ILI9341
+	#define LCD_WIDTH 240
+	#define LCD_HEIGHT 320
+	#define LCD_GRAMH 320
+	#define LCD_FRAME_US 12658 //1フレームの走査時間（フレームレート79Hz）
+#elif LCD_CONTROLLER == LCD_ST7789
+	#define LCD_WIDTH 240
+	#ifndef LCD_HEIGHT
+	#define LCD_HEIGHT 320 // 240x240パネルの場合は240を指定
+	#endif
+	#define LCD_GRAMH 320
+	#define LCD_FRAME_US 16667 //60Hz
+#elif LCD_CONTROLLER == LCD_ILI9488
+	#define LCD_WIDTH 320
+	#define LCD_HEIGHT 480
+	#define LCD_GRAMH 480
+	#define LCD_FRAME_US 16458 //60.76Hz
+#else
+	#error "Unknown LCD_CONTROLLER"
+#endif
+
 #define VERTICAL 0
 #define HORIZONTAL 1
+#ifndef LCD_ALIGNMENT
 #define LCD_ALIGNMENT VERTICAL
 //#define LCD_ALIGNMENT HORIZONTAL
+#endif
 
 #if LCD_ALIGNMENT == VERTICAL
-	#define X_RES 240 // 横方向解像度
-	#define Y_RES 320 // 縦方向解像度
+	#define X_RES LCD_WIDTH // 横方向解像度
+	#define Y_RES LCD_HEIGHT // 縦方向解像度
 #else
-	#define X_RES 320 // 横方向解像度
-	#define Y_RES 240 // 縦方向解像度
+	#define X_RES LCD_HEIGHT // 横方向解像度
+	#define Y_RES LCD_WIDTH // 縦方向解像度
 #endif
 
+// フォントの拡大率（1文字の表示サイズは8*LCD_SCALEドット四方）
+// 2以上はgraphlibのみを使うアプリケーション用。テトリスのゲーム画面（30*27文字）は
+// 16ドット四方ではどの液晶にも収まらないため、tetrispico.cは1でのみビルドできる
+// graphlibの文字用のバッファは拡大率の2乗に比例して大きくなるため、4までとする
+#ifndef LCD_SCALE
+#define LCD_SCALE 1
+#endif
+#if LCD_SCALE < 1 || LCD_SCALE > 4
+#error "LCD_SCALE must be 1 to 4"
+#endif
+#define FONTSIZE (8*LCD_SCALE)
+
 #define LCD_CS 11 //GPIO11
 #define LCD_DC 12 //GPIO12
 #define LCD_RESET 13 //GPIO13
 #define SPICH spi0
+#ifndef LCD_TE
+#define LCD_TE -1 //TE(Tearing Effect)出力を接続したGPIO、-1の場合は接続なし（走査位置を時間から推定）
+#endif
+#define LCD_TE_MARGIN 16 //描画中に走査線が追いつかないよう、走査線の手前に空けるライン数
+
+// 液晶への画素の送信形式
+#define LCD_COLOR16 16 // RGB565、1画素2バイト
+#define LCD_COLOR12 12 // RGB444、2画素を3バイトに詰める
+#define LCD_COLOR18 18 // RGB666、1画素3バイト（各バイトの上位6ビット）
+#ifndef LCD_COLORMODE
+#if LCD_CONTROLLER == LCD_ILI9488
+#define LCD_COLORMODE LCD_COLOR18
+#else
+#define LCD_COLORMODE LCD_COLOR16
+#endif
+#endif
+#if LCD_CONTROLLER == LCD_ILI9488 && LCD_COLORMODE != LCD_COLOR18
+#error "ILI9488 supports only LCD_COLOR18 on SPI"
+#endif
+
+#if LCD_COLORMODE == LCD_COLOR12
+	#define LCD_RGB(r,g,b) ((((r)>>4)<<8)+(((g)>>4)<<4)+((b)>>4)) // 8ビットRGBから画素色へ変換
+	#define LCD_PIXBYTES(n) (((n)*3+1)/2) // n画素分の送信バイト数
+#elif LCD_COLORMODE == LCD_COLOR18
+	// 画素色はRGB565で保持し、送信時に各色1バイトに展開する
+	#define LCD_RGB(r,g,b) ((((r)>>3)<<11)+(((g)>>2)<<5)+((b)>>3))
+	#define LCD_PIXBYTES(n) ((n)*3)
+#else
+	#define LCD_RGB(r,g,b) ((((r)>>3)<<11)+(((g)>>2)<<5)+((b)>>3))
+	#define LCD_PIXBYTES(n) ((n)*2)
+#endif
+#define LCD_QBUFSIZE 512 //転送キューのバッファ1つ分のバイト数
+
+#ifndef LCD_STATS
+#define LCD_STATS 0 //1にすると液晶転送の統計情報を取る
+#endif
+
+//液晶転送の統計情報
+typedef struct {
+	unsigned int cs; //CSアサート回数
+	unsigned int dc; //DC切り替え回数
+	unsigned int bytes; //送信バイト数
+	unsigned int winskip; //省略したCASET/PASETコマンド数
+	unsigned int wincont; //Memory Write Continueで済ませたウィンドウ設定数
+	unsigned int cells; //タイルマップから送信したセル数
+	unsigned int rects; //タイルマップから送信した長方形の数
+	unsigned int ghit; //グリフキャッシュのヒット数
+	unsigned int gmiss; //グリフキャッシュのミス数
+} _LCDstats;
+extern _LCDstats lcdstats;
+#if LCD_STATS
+#define LCD_STAT(m,n) (lcdstats.m+=(n))
+void LCD_PrintStats(const char *s);
+#else
+#define LCD_STAT(m,n) ((void)0)
+#endif
 
 void LCD_WriteComm(unsigned char comm);
 void LCD_WriteData(unsigned char data);
 void LCD_WriteData2(unsigned short data);
 void LCD_WriteDataN(unsigned char *b,int n);
+void LCD_TxBegin(void);
+void LCD_TxEnd(void);
+void LCD_TxComm(unsigned char comm);
+void LCD_TxData(const unsigned char *b,int n);
+void LCD_TxQueue(const unsigned char *b,int n);
+void LCD_TxDMA(const unsigned char *b,int n);
+void LCD_TxData2(unsigned short data);
+int LCD_PackPixels(unsigned char *b,const unsigned short *c,int n);
+void LCD_TxWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h);
 void LCD_Init(void);
+void LCD_InitBegin(void);
+void LCD_InitEnd(void);
+void LCD_DisplayOn(void);
 void LCD_SetCursor(unsigned short x, unsigned short y);
 void LCD_Clear(unsigned short color);
+void LCD_Fill(unsigned short x,unsigned short y,unsigned short w,unsigned short h,unsigned short color);
+void LCD_continuous_output(unsigned short x,unsigned short y,unsigned short color,int n);
+void LCD_WaitDMA(void);
 void drawPixel(unsigned short x, unsigned short y, unsigned short color);
+void LCD_SetScroll(unsigned short s);
+int LCD_ScanDistance(unsigned short x,unsigned short y);
+void LCD_WaitScanOut(unsigned short x,unsigned short y,unsigned short w,unsigned short h);
@@ -0,0 +1,434 @@
+//フォントの点の並びを長方形に分けた表（tools/mkfontspan.cで生成）
+//文字nの長方形はFontSpan[FontSpanIndex[n]]からFontSpan[FontSpanIndex[n+1]-1]まで
+//1つの長方形を2バイトで表す。1バイト目:上位4ビットがy、下位4ビットが高さ-1
+//2バイト目:上位4ビットがx、下位4ビットが幅-1
+
+const unsigned char FontSpan[]={
+	0x06,0x06, //0x01
+	0x07,0x07, //0x02
+	0x02,0x02,0x02,0x43,0x42,0x06, //0x03
+	0x30,0x43,0x40,0x34,0x52,0x31, //0x04
+	0x07,0x31, //0x05
+	0x02,0x31,0x30,0x34,0x40,0x43, //0x06
+	0x31,0x07, //0x07
+	0x30,0x03,0x40,0x04,0x52,0x31, //0x08
+	0x02,0x31,0x30,0x04,0x40,0x03, //0x09
+	0x10,0x43,0x20,0x07,0x31,0x16,0x50,0x22,0x52,0x61, //0x0A
+	0x00,0x04,0x10,0x05,0x20,0x06,0x30,0x05,0x40,0x01,0x43,0x70, //0x0B
+	0x52,0x00, //0x0B
+	0x00,0x61,0x10,0x25,0x20,0x07,0x30,0x05,0x43,0x01,0x60,0x51, //0x0C
+	0x70,0x34, //0x0C
+	0x00,0x01,0x10,0x02,0x20,0x01,0x20,0x43,0x31,0x34,0x50,0x51, //0x0D
+	0x00,0x52,0x12,0x07,0x40,0x04,0x51,0x12,0x70,0x13, //0x0E
+	0x00,0x00,0x11,0x01,0x10,0x52,0x21,0x43,0x30,0x00,0x41,0x33, //0x0F
+	0x60,0x43,0x70,0x52, //0x0F
+	0x00,0x03,0x10,0x05,0x20,0x06,0x30,0x43,0x41,0x52,0x60,0x42, //0x10
+	0x70,0x22, //0x10
+	0x00,0x32,0x11,0x24,0x30,0x33,0x40,0x42,0x50,0x43,0x61,0x52, //0x11
+	0x00,0x70,0x10,0x61,0x20,0x43,0x30,0x42,0x42,0x32,0x60,0x70, //0x12
+	0x70,0x00,0x70,0x34, //0x12
+	0x00,0x02,0x11,0x05,0x30,0x32,0x60,0x02,0x70,0x04, //0x13
+	0x00,0x61,0x14,0x70, //0x14
+	0x02,0x00,0x00,0x70,0x30,0x01,0x41,0x02,0x60,0x03,0x70,0x11, //0x15
+	0x00,0x07,0x10,0x05,0x20,0x03,0x30,0x02,0x41,0x01,0x50,0x43, //0x16
+	0x60,0x07,0x70,0x14, //0x16
+	0x30,0x20,0x41,0x03,0x60,0x02, //0x17
+	0x03,0x22,0x40,0x32,0x50,0x33,0x60,0x43,0x70,0x51, //0x18
+	0x01,0x52,0x21,0x61,0x41,0x70,0x61,0x61, //0x19
+	0x00,0x05,0x10,0x01,0x10,0x32,0x21,0x00,0x20,0x33,0x31,0x43, //0x1A
+	0x42,0x01,0x51,0x52,0x70,0x02,0x70,0x61, //0x1A
+	0x01,0x52,0x22,0x61,0x50,0x00,0x51,0x52,0x60,0x02,0x70,0x00, //0x1B
+	0x70,0x61, //0x1B
+	0x04,0x00,0x00,0x43,0x10,0x52,0x40,0x42,0x51,0x01,0x51,0x43, //0x1C
+	0x70,0x00,0x70,0x61, //0x1C
+	0x00,0x05,0x10,0x24,0x21,0x42,0x40,0x33,0x50,0x05,0x60,0x04, //0x1D
+	0x70,0x03, //0x1D
+	0x00,0x30,0x10,0x20,0x10,0x40,0x20,0x10,0x20,0x50,0x30,0x02, //0x1E
+	0x30,0x42,0x42,0x20,0x42,0x40, //0x1E
+	0x02,0x20,0x02,0x40,0x30,0x02,0x30,0x42,0x40,0x10,0x40,0x50, //0x1F
+	0x50,0x20,0x50,0x40,0x60,0x30, //0x1F
+	0x03,0x22,0x51,0x22, //0x21
+	0x01,0x20,0x01,0x50, //0x22
+	0x10,0x20,0x10,0x50,0x20,0x15,0x31,0x20,0x31,0x50,0x50,0x15, //0x23
+	0x60,0x20,0x60,0x50, //0x23
+	0x00,0x20,0x00,0x40,0x10,0x15,0x20,0x00,0x20,0x20,0x20,0x40, //0x24
+	0x30,0x14,0x40,0x20,0x40,0x40,0x40,0x60,0x50,0x05,0x60,0x20, //0x24
+	0x60,0x40, //0x24
+	0x21,0x11,0x20,0x50,0x30,0x40,0x40,0x30,0x50,0x20,0x51,0x41, //0x25
+	0x60,0x10, //0x25
+	0x00,0x21,0x10,0x10,0x10,0x40,0x20,0x21,0x30,0x10,0x30,0x30, //0x26
+	0x41,0x00,0x41,0x41,0x60,0x12,0x60,0x60, //0x26
+	0x01,0x31,0x20,0x40,0x30,0x30, //0x27
+	0x00,0x31,0x14,0x21,0x60,0x31, //0x28
+	0x00,0x21,0x14,0x31,0x60,0x21, //0x29
+	0x11,0x30,0x20,0x10,0x20,0x50,0x31,0x22,0x50,0x10,0x51,0x30, //0x2A
+	0x50,0x50, //0x2A
+	0x21,0x30,0x40,0x14,0x51,0x30, //0x2B
+	0x41,0x31,0x60,0x40,0x70,0x30, //0x2C
+	0x40,0x14, //0x2D
+	0x51,0x31, //0x2E
+	0x10,0x60,0x20,0x50,0x30,0x40,0x40,0x30,0x50,0x20,0x60,0x10, //0x2F
+	0x00,0x14,0x14,0x02,0x14,0x42,0x60,0x14, //0x30
+	0x00,0x32,0x10,0x23,0x24,0x32, //0x31
+	0x00,0x14,0x11,0x02,0x12,0x42,0x40,0x23,0x50,0x03,0x60,0x06, //0x32
+	0x00,0x14,0x10,0x02,0x11,0x42,0x30,0x23,0x41,0x42,0x50,0x02, //0x33
+	0x60,0x14, //0x33
+	0x00,0x32,0x10,0x23,0x20,0x14,0x30,0x05,0x40,0x01,0x40,0x32, //0x34
+	0x50,0x06,0x60,0x32, //0x34
+	0x00,0x06,0x10,0x02,0x20,0x05,0x30,0x02,0x32,0x42,0x50,0x02, //0x35
+	0x60,0x14, //0x35
+	0x00,0x14,0x11,0x02,0x10,0x42,0x30,0x05,0x41,0x02,0x41,0x42, //0x36
+	0x60,0x14, //0x36
+	0x00,0x06,0x11,0x42,0x31,0x32,0x51,0x22, //0x37
+	0x00,0x14,0x11,0x02,0x11,0x42,0x30,0x14,0x41,0x02,0x41,0x42, //0x38
+	0x60,0x14, //0x38
+	0x00,0x14,0x11,0x02,0x11,0x42,0x30,0x15,0x41,0x42,0x50,0x02, //0x39
+	0x60,0x14, //0x39
+	0x11,0x31,0x41,0x31, //0x3A
+	0x11,0x31,0x41,0x31,0x60,0x40,0x70,0x30, //0x3B
+	0x00,0x32,0x10,0x22,0x20,0x12,0x30,0x02,0x40,0x12,0x50,0x22, //0x3C
+	0x60,0x32, //0x3C
+	0x11,0x14,0x41,0x14, //0x3D
+	0x00,0x12,0x10,0x22,0x20,0x32,0x30,0x42,0x40,0x32,0x50,0x22, //0x3E
+	0x60,0x12, //0x3E
+	0x00,0x14,0x10,0x02,0x11,0x42,0x30,0x32,0x40,0x22,0x60,0x22, //0x3F
+	0x00,0x22,0x10,0x10,0x10,0x50,0x22,0x00,0x20,0x31,0x21,0x60, //0x40
+	0x30,0x20,0x30,0x40,0x40,0x30,0x40,0x51,0x50,0x10,0x60,0x23, //0x40
+	0x00,0x14,0x10,0x06,0x21,0x02,0x21,0x42,0x40,0x06,0x51,0x02, //0x41
+	0x51,0x42, //0x41
+	0x00,0x05,0x11,0x02,0x11,0x42,0x30,0x05,0x41,0x02,0x41,0x42, //0x42
+	0x60,0x05, //0x42
+	0x00,0x14,0x14,0x02,0x11,0x42,0x41,0x42,0x60,0x14, //0x43
+	0x00,0x05,0x14,0x02,0x14,0x42,0x60,0x05, //0x44
+	0x00,0x06,0x11,0x02,0x30,0x04,0x41,0x02,0x60,0x06, //0x45
+	0x00,0x06,0x11,0x02,0x30,0x04,0x42,0x02, //0x46
+	0x00,0x14,0x11,0x02,0x10,0x42,0x30,0x06,0x41,0x02,0x41,0x42, //0x47
+	0x60,0x15, //0x47
+	0x02,0x02,0x02,0x42,0x30,0x06,0x42,0x02,0x42,0x42, //0x48
+	0x06,0x22, //0x49
+	0x05,0x32,0x50,0x01,0x60,0x13, //0x4A
+	0x00,0x02,0x00,0x42,0x10,0x05,0x20,0x04,0x30,0x03,0x40,0x04, //0x4B
+	0x50,0x05,0x60,0x02,0x60,0x42, //0x4B
+	0x05,0x02,0x60,0x06, //0x4C
+	0x00,0x01,0x00,0x51,0x10,0x02,0x10,0x42,0x21,0x06,0x42,0x01, //0x4D
+	0x40,0x30,0x42,0x51, //0x4D
+	0x00,0x01,0x02,0x51,0x10,0x02,0x20,0x03,0x30,0x06,0x42,0x01, //0x4E
+	0x40,0x33,0x50,0x42,0x60,0x51, //0x4E
+	0x00,0x14,0x14,0x02,0x14,0x42,0x60,0x14, //0x4F
+	0x00,0x05,0x12,0x02,0x12,0x42,0x40,0x05,0x51,0x02, //0x50
+	0x00,0x14,0x12,0x02,0x12,0x42,0x40,0x06,0x50,0x02,0x50,0x42, //0x51
+	0x60,0x15, //0x51
+	0x00,0x05,0x12,0x02,0x12,0x42,0x40,0x05,0x51,0x02,0x51,0x42, //0x52
+	0x00,0x14,0x11,0x02,0x10,0x42,0x30,0x14,0x41,0x42,0x50,0x02, //0x53
+	0x60,0x14, //0x53
+	0x00,0x06,0x15,0x22, //0x54
+	0x05,0x02,0x05,0x42,0x60,0x14, //0x55
+	0x04,0x02,0x04,0x42,0x50,0x11,0x50,0x41,0x60,0x22, //0x56
+	0x03,0x01,0x03,0x51,0x12,0x30,0x41,0x06,0x60,0x10,0x60,0x30, //0x57
+	0x60,0x50, //0x57
+	0x00,0x01,0x00,0x51,0x10,0x02,0x10,0x42,0x20,0x14,0x30,0x22, //0x58
+	0x40,0x14,0x50,0x02,0x50,0x42,0x60,0x01,0x60,0x51, //0x58
+	0x00,0x01,0x00,0x51,0x10,0x02,0x10,0x42,0x20,0x14,0x33,0x22, //0x59
+	0x00,0x06,0x10,0x42,0x20,0x32,0x30,0x22,0x40,0x12,0x50,0x02, //0x5A
+	0x60,0x06, //0x5A
+	0x00,0x30,0x10,0x31,0x20,0x03,0x20,0x50,0x30,0x60,0x40,0x03, //0x5B
+	0x40,0x50,0x50,0x31,0x60,0x30, //0x5B
+	0x00,0x30,0x10,0x21,0x20,0x10,0x20,0x33,0x30,0x00,0x40,0x10, //0x5C
+	0x40,0x33,0x50,0x21,0x60,0x30, //0x5C
+	0x00,0x02,0x00,0x40,0x11,0x00,0x10,0x41,0x22,0x40,0x22,0x60, //0x5D
+	0x30,0x01,0x41,0x00,0x50,0x41,0x60,0x02,0x60,0x40, //0x5D
+	0x00,0x22,0x10,0x10,0x10,0x50,0x23,0x00,0x20,0x31,0x23,0x60, //0x5E
+	0x31,0x20,0x50,0x31,0x60,0x10,0x60,0x50,0x70,0x22, //0x5E
+	0x00,0x12,0x06,0x61,0x14,0x01,0x14,0x31,0x60,0x12, //0x5F
+	0x00,0x01,0x00,0x33,0x11,0x31,0x30,0x00,0x30,0x32,0x42,0x31, //0x60
+	0x00,0x06,0x14,0x00,0x14,0x60,0x21,0x40,0x40,0x22,0x60,0x06, //0x61
+	0x02,0x10,0x30,0x00,0x40,0x01,0x50,0x10,0x60,0x11,0x70,0x10, //0x62
+	0x33,0x00,0x70,0x01, //0x63
+	0x07,0x10, //0x64
+	0x00,0x10,0x20,0x01,0x30,0x00,0x61,0x00, //0x65
+	0x00,0x10,0x11,0x11,0x32,0x10,0x61,0x11, //0x66
+	0x60,0x70,0x70,0x61, //0x67
+	0x03,0x01,0x41,0x00,0x60,0x01,0x70,0x02, //0x68
+	0x52,0x70, //0x69
+	0x00,0x11,0x12,0x03,0x40,0x00,0x40,0x21,0x50,0x04,0x60,0x10, //0x6A
+	0x61,0x30, //0x6A
+	0x01,0x60,0x20,0x52,0x30,0x41,0x30,0x70,0x40,0x40,0x40,0x61, //0x6B
+	0x50,0x34,0x61,0x43, //0x6B
+	0x10,0x00,0x21,0x01,0x21,0x30,0x41,0x03,0x60,0x01,0x60,0x31, //0x6C
+	0x70,0x04, //0x6C
+	0x50,0x61,0x60,0x42,0x70,0x31, //0x6D
+	0x02,0x00,0x02,0x21,0x30,0x03,0x43,0x00,0x40,0x30,0x50,0x32, //0x6E
+	0x50,0x70,0x61,0x20,0x60,0x61,0x70,0x40,0x70,0x60, //0x6E
+	0x60,0x02,0x70,0x20, //0x6F
+	0x00,0x34,0x10,0x40,0x10,0x70,0x20,0x43,0x30,0x41,0x31,0x70, //0x70
+	0x41,0x50,0x60,0x52,0x70,0x51, //0x70
+	0x01,0x01,0x00,0x31,0x21,0x02,0x40,0x00,0x40,0x21,0x52,0x01, //0x71
+	0x52,0x30, //0x71
+	0x20,0x70,0x30,0x61,0x40,0x50,0x41,0x70,0x51,0x40,0x70,0x30, //0x72
+	0x70,0x50, //0x72
+	0x00,0x11,0x06,0x50,0x10,0x01,0x12,0x30,0x14,0x70,0x20,0x00, //0x73
+	0x30,0x10,0x40,0x12,0x50,0x00,0x52,0x20,0x70,0x00,0x70,0x40, //0x73
+	0x70,0x70, //0x73
+	0x00,0x00,0x03,0x20,0x04,0x40,0x02,0x60,0x21,0x00,0x30,0x70, //0x74
+	0x40,0x61,0x50,0x25,0x60,0x04,0x70,0x12, //0x74
+	0x01,0x00,0x00,0x40,0x10,0x50,0x22,0x10,0x23,0x30,0x20,0x60, //0x75
+	0x41,0x50,0x50,0x01,0x60,0x02,0x61,0x60,0x70,0x21, //0x75
+	0x40,0x00,0x70,0x20, //0x76
+	0x40,0x70,0x50,0x42,0x60,0x31,0x60,0x70,0x70,0x21,0x70,0x52, //0x77
+	0x10,0x61,0x20,0x33,0x30,0x03,0x30,0x70,0x40,0x00,0x40,0x52, //0x78
+	0x50,0x10,0x51,0x40,0x51,0x60,0x60,0x00,0x60,0x20,0x70,0x10, //0x78
+	0x70,0x30,0x70,0x50, //0x78
+	0x00,0x31,0x10,0x05,0x16,0x70,0x21,0x10,0x21,0x30,0x22,0x50, //0x79
+	0x40,0x21,0x52,0x00,0x52,0x20,0x50,0x41,0x61,0x40, //0x79
+	0x16,0x10,0x10,0x40,0x10,0x60,0x20,0x30,0x30,0x31,0x33,0x70, //0x7A
+	0x41,0x30,0x41,0x50,0x60,0x32,0x70,0x31,0x70,0x60, //0x7A
+	0x20,0x11,0x30,0x20,0x30,0x40,0x41,0x10,0x40,0x31,0x40,0x60, //0x7B
+	0x60,0x00,0x61,0x20,0x60,0x50,0x70,0x40, //0x7B
+	0x60,0x01,0x70,0x20, //0x7C
+	0x60,0x70,0x70,0x60, //0x7D
+	0x00,0x30,0x00,0x52,0x10,0x20,0x10,0x41,0x20,0x11,0x20,0x40, //0x7E
+	0x30,0x13,0x40,0x12,0x50,0x03,0x61,0x10, //0x7E
+	0x00,0x01,0x00,0x40,0x00,0x61,0x10,0x02,0x11,0x50,0x20,0x12, //0x7F
+	0x20,0x70,0x30,0x22,0x31,0x61,0x43,0x31,0x52,0x10,0x50,0x60, //0x7F
+	0x70,0x60, //0x7F
+	0x00,0x03,0x10,0x01,0x20,0x00, //0x80
+	0x00,0x32,0x10,0x20,0x10,0x40,0x11,0x70,0x20,0x50,0x30,0x42, //0x81
+	0x40,0x40,0x42,0x60,0x60,0x40,0x70,0x42, //0x81
+	0x00,0x00,0x00,0x30,0x10,0x21,0x20,0x41,0x30,0x20,0x30,0x50, //0x82
+	0x40,0x12,0x42,0x60,0x50,0x13,0x60,0x10,0x60,0x31,0x70,0x01, //0x82
+	0x70,0x42, //0x82
+	0x10,0x70,0x20,0x61,0x30,0x51,0x40,0x41,0x40,0x70,0x50,0x31, //0x83
+	0x50,0x61,0x60,0x32,0x60,0x70,0x70,0x25, //0x83
+	0x00,0x02,0x00,0x41,0x00,0x70,0x10,0x00,0x10,0x21,0x10,0x52, //0x84
+	0x20,0x15,0x30,0x01,0x30,0x31,0x30,0x60,0x40,0x00,0x40,0x20, //0x84
+	0x40,0x42,0x50,0x02,0x51,0x50,0x51,0x70,0x60,0x01,0x60,0x30, //0x84
+	0x70,0x07, //0x84
+	0x00,0x10,0x01,0x30,0x02,0x50,0x04,0x70,0x13,0x00,0x22,0x20, //0x85
+	0x31,0x41,0x51,0x11,0x52,0x40,0x52,0x61,0x70,0x10, //0x85
+	0x01,0x20,0x07,0x40,0x01,0x70,0x21,0x11,0x25,0x61,0x40,0x10, //0x86
+	0x50,0x11,0x61,0x10, //0x86
+	0x04,0x10,0x01,0x31,0x04,0x60,0x25,0x40,0x51,0x11,0x52,0x61, //0x87
+	0x70,0x10, //0x87
+	0x02,0x00,0x00,0x20,0x00,0x40,0x00,0x61,0x13,0x50,0x24,0x30, //0x88
+	0x30,0x01,0x30,0x70,0x43,0x10,0x52,0x60,0x70,0x31, //0x88
+	0x00,0x30,0x10,0x00,0x10,0x31,0x20,0x10,0x21,0x40,0x30,0x60, //0x89
+	0x40,0x30,0x40,0x50,0x52,0x00,0x50,0x51,0x60,0x20,0x60,0x50, //0x89
+	0x70,0x60, //0x89
+	0x60,0x00,0x70,0x10, //0x8A
+	0x01,0x60,0x30,0x60,0x41,0x50,0x60,0x52,0x70,0x50,0x70,0x70, //0x8B
+	0x00,0x10,0x11,0x01,0x34,0x00, //0x8C
+	0x00,0x33,0x10,0x32,0x20,0x30,0x20,0x51,0x30,0x33,0x43,0x21, //0x8D
+	0x50,0x50,0x60,0x51,0x70,0x60, //0x8D
+	0x00,0x43,0x10,0x40,0x10,0x70,0x21,0x51,0x32,0x30,0x43,0x60, //0x8E
+	0x61,0x31, //0x8E
+	0x01,0x01,0x06,0x41,0x02,0x70,0x42,0x00,0x42,0x70,0x70,0x01, //0x8F
+	0x70,0x40,0x70,0x61, //0x8F
+	0x50,0x00, //0x90
+	0x40,0x70,0x51,0x61,0x70,0x51, //0x91
+	0x00,0x13,0x00,0x61,0x10,0x10,0x10,0x33,0x20,0x07,0x30,0x00, //0x92
+	0x30,0x25,0x40,0x07,0x50,0x16,0x60,0x06,0x70,0x03,0x70,0x70, //0x92
+	0x00,0x00,0x00,0x20,0x00,0x43,0x11,0x02,0x11,0x40,0x10,0x61, //0x93
+	0x22,0x60,0x30,0x04,0x40,0x10,0x40,0x31,0x50,0x01,0x50,0x30, //0x93
+	0x50,0x51,0x60,0x50,0x70,0x02,0x70,0x70, //0x93
+	0x00,0x10,0x02,0x31,0x00,0x61,0x12,0x01,0x12,0x60,0x30,0x30, //0x94
+	0x41,0x03,0x40,0x51,0x50,0x50,0x61,0x00,0x60,0x21,0x60,0x52, //0x94
+	0x70,0x20,0x70,0x43, //0x94
+	0x00,0x10,0x00,0x40,0x04,0x61,0x10,0x01,0x13,0x31,0x20,0x10, //0x95
+	0x30,0x01,0x40,0x10,0x50,0x02,0x50,0x70,0x60,0x05,0x70,0x06, //0x95
+	0x07,0x10,0x07,0x40,0x00,0x61,0x15,0x70,0x70,0x61, //0x96
+	0x01,0x10,0x01,0x31,0x01,0x60,0x21,0x11,0x20,0x40,0x21,0x70, //0x97
+	0x30,0x41,0x41,0x02,0x40,0x43,0x50,0x41,0x52,0x70,0x60,0x01, //0x97
+	0x60,0x50,0x70,0x14, //0x97
+	0x00,0x00,0x00,0x40,0x00,0x60,0x14,0x30,0x10,0x52,0x23,0x10, //0x98
+	0x23,0x50,0x23,0x70,0x60,0x42,0x70,0x00,0x70,0x20,0x70,0x60, //0x98
+	0x01,0x20,0x10,0x00,0x20,0x31,0x31,0x10,0x40,0x40,0x52,0x00, //0x99
+	0x50,0x30,0x60,0x50,0x70,0x30,0x70,0x60, //0x99
+	0x00,0x50,0x13,0x52,0x51,0x40,0x51,0x61,0x70,0x52, //0x9A
+	0x01,0x00,0x31,0x00,0x60,0x10, //0x9B
+	0x02,0x21,0x00,0x60,0x25,0x60,0x30,0x30,0x43,0x21, //0x9C
+	0x00,0x30,0x03,0x60,0x12,0x40,0x40,0x41,0x52,0x40, //0x9D
+	0x07,0x00,0x01,0x61,0x20,0x60,0x70,0x60, //0x9E
+	0x01,0x52,0x20,0x41,0x21,0x70,0x30,0x31,0x40,0x25,0x50,0x20, //0x9F
+	0x50,0x50,0x61,0x10,0x60,0x40,0x60,0x60,0x70,0x34, //0x9F
+	0x00,0x03,0x00,0x52,0x10,0x01,0x11,0x34,0x20,0x00,0x30,0x16, //0xA0
+	0x41,0x00,0x40,0x25,0x50,0x23,0x50,0x70,0x60,0x13,0x60,0x61, //0xA0
+	0x70,0x10,0x70,0x34, //0xA0
+	0x00,0x06,0x11,0x05,0x11,0x70,0x31,0x07,0x50,0x01,0x50,0x33, //0xA1
+	0x60,0x07,0x70,0x01,0x70,0x34, //0xA1
+	0x00,0x10,0x00,0x34,0x10,0x16,0x20,0x00,0x20,0x25,0x30,0x16, //0xA2
+	0x40,0x07,0x50,0x13,0x50,0x61,0x60,0x07,0x70,0x00,0x70,0x25, //0xA2
+	0x05,0x07,0x60,0x01,0x60,0x32,0x60,0x70,0x70,0x07, //0xA3
+	0x00,0x43,0x10,0x00,0x10,0x40,0x10,0x61,0x20,0x07,0x31,0x03, //0xA4
+	0x31,0x52,0x51,0x01,0x51,0x50,0x51,0x70,0x60,0x30,0x70,0x07, //0xA4
+	0x01,0x07,0x20,0x05,0x20,0x70,0x31,0x07,0x50,0x00,0x50,0x22, //0xA5
+	0x50,0x70,0x60,0x24,0x70,0x25, //0xA5
+	0x01,0x00,0x01,0x20,0x01,0x40,0x01,0x60,0x21,0x02,0x21,0x50, //0xA6
+	0x22,0x70,0x40,0x03,0x50,0x00,0x50,0x30,0x50,0x60,0x60,0x01, //0xA6
+	0x60,0x31,0x70,0x10,0x70,0x42, //0xA6
+	0x00,0x00,0x00,0x20,0x00,0x60,0x10,0x01,0x20,0x10,0x20,0x40, //0xA7
+	0x30,0x11,0x30,0x60,0x40,0x30,0x40,0x50,0x50,0x10,0x50,0x41, //0xA7
+	0x70,0x31, //0xA7
+	0x20,0x00,0x40,0x00, //0xA8
+	0x00,0x52,0x10,0x61,0x21,0x60,0x40,0x61,0x52,0x60, //0xA9
+	0x33,0x10, //0xAA
+	0x01,0x21,0x23,0x20,0x30,0x60,0x40,0x52,0x50,0x43,0x60,0x16, //0xAB
+	0x70,0x23,0x70,0x70, //0xAB
+	0x40,0x42,0x50,0x00,0x50,0x50,0x60,0x03,0x60,0x52,0x70,0x01, //0xAC
+	0x70,0x51, //0xAC
+	0x02,0x40,0x20,0x60,0x31,0x30,0x31,0x51,0x52,0x40,0x52,0x60, //0xAD
+	0x70,0x00, //0xAD
+	0x02,0x00,0x00,0x51,0x16,0x60,0x33,0x01,0x70,0x02, //0xAE
+	0x10,0x61,0x20,0x60,0x42,0x50,0x41,0x70,0x70,0x52, //0xAF
+	0x00,0x03,0x00,0x51,0x10,0x06,0x22,0x05,0x24,0x70,0x50,0x04, //0xB0
+	0x61,0x05, //0xB0
+	0x00,0x10,0x00,0x30,0x00,0x52,0x10,0x07,0x25,0x00,0x20,0x25, //0xB1
+	0x31,0x21,0x31,0x52,0x50,0x22,0x50,0x61,0x61,0x21,0x61,0x52, //0xB1
+	0x00,0x01,0x00,0x33,0x10,0x32,0x10,0x70,0x20,0x23,0x31,0x10, //0xB2
+	0x30,0x43,0x40,0x34,0x50,0x24,0x60,0x20,0x61,0x43,0x70,0x02, //0xB2
+	0x00,0x21,0x00,0x52,0x10,0x00,0x10,0x30,0x10,0x60,0x20,0x01, //0xB3
+	0x20,0x33,0x30,0x06,0x40,0x00,0x40,0x32,0x42,0x70,0x50,0x03, //0xB3
+	0x50,0x50,0x60,0x05,0x70,0x00,0x70,0x34, //0xB3
+	0x00,0x25,0x11,0x03,0x11,0x52,0x30,0x11,0x31,0x43,0x40,0x00, //0xB4
+	0x40,0x20,0x50,0x05,0x50,0x70,0x60,0x03,0x60,0x52,0x70,0x02, //0xB4
+	0x70,0x41,0x70,0x70, //0xB4
+	0x01,0x00,0x00,0x30,0x00,0x70,0x10,0x20,0x21,0x03,0x20,0x60, //0xB5
+	0x31,0x70,0x40,0x00,0x40,0x20,0x50,0x02,0x60,0x06,0x70,0x00, //0xB5
+	0x70,0x70, //0xB5
+	0x02,0x20,0x01,0x51,0x20,0x52,0x30,0x25,0x40,0x22,0x40,0x60, //0xB6
+	0x50,0x10,0x52,0x61,0x60,0x20,0x70,0x21, //0xB6
+	0x00,0x14,0x11,0x02,0x10,0x41,0x20,0x42,0x30,0x11,0x34,0x41, //0xB7
+	0x41,0x20,0x60,0x11,0x60,0x70,0x70,0x20, //0xB7
+	0x00,0x00,0x00,0x50,0x10,0x60,0x20,0x40,0x21,0x70,0x30,0x32, //0xB8
+	0x40,0x31,0x40,0x60,0x50,0x40,0x60,0x50,0x70,0x20,0x70,0x51, //0xB8
+	0x00,0x00,0x10,0x10,0x40,0x00,0x40,0x20,0x50,0x02,0x70,0x00, //0xB9
+	0x00,0x60,0x11,0x61,0x30,0x60,0x41,0x61,0x60,0x60, //0xBA
+	0x10,0x61,0x20,0x20,0x20,0x52,0x30,0x25,0x40,0x04,0x50,0x01, //0xBB
+	0x50,0x52,0x60,0x34,0x70,0x05, //0xBB
+	0x00,0x07,0x10,0x03,0x10,0x60,0x20,0x01,0x20,0x70,0x30,0x34, //0xBC
+	0x40,0x16,0x51,0x02,0x52,0x43,0x70,0x01, //0xBC
+	0x00,0x01,0x00,0x30,0x00,0x70,0x10,0x10,0x10,0x40,0x10,0x60, //0xBD
+	0x31,0x07,0x50,0x13,0x60,0x02,0x70,0x52, //0xBD
+	0x00,0x02,0x00,0x42,0x10,0x16,0x20,0x70,0x30,0x07,0x40,0x00, //0xBE
+	0x40,0x33,0x50,0x20,0x50,0x51,0x60,0x03,0x60,0x61,0x70,0x05, //0xBE
+	0x00,0x00,0x00,0x21,0x00,0x60,0x10,0x10,0x10,0x42,0x20,0x20, //0xBF
+	0x20,0x51,0x30,0x00,0x30,0x42,0x40,0x01,0x40,0x51,0x52,0x00, //0xBF
+	0x50,0x20,0x50,0x60,0x70,0x20, //0xBF
+	0x02,0x51,0x30,0x52,0x40,0x51,0x50,0x50,0x60,0x51,0x70,0x60, //0xC0
+	0x02,0x04,0x02,0x70,0x30,0x07,0x43,0x04,0x40,0x61,0x50,0x60, //0xC1
+	0x70,0x61, //0xC1
+	0x00,0x00,0x00,0x25,0x10,0x04,0x10,0x61,0x20,0x23,0x20,0x70, //0xC2
+	0x30,0x02,0x40,0x00,0x40,0x52,0x50,0x25,0x60,0x03,0x60,0x51, //0xC2
+	0x70,0x01,0x70,0x43, //0xC2
+	0x00,0x01,0x00,0x33,0x10,0x34,0x20,0x25,0x40,0x11,0x40,0x52, //0xC3
+	0x50,0x07,0x60,0x13,0x60,0x61,0x70,0x07, //0xC3
+	0x00,0x00,0x00,0x30,0x00,0x50,0x01,0x70,0x10,0x03,0x20,0x07, //0xC4
+	0x30,0x01,0x50,0x07,0x60,0x00,0x60,0x23,0x60,0x70,0x70,0x03, //0xC4
+	0x70,0x52, //0xC4
+	0x00,0x16,0x11,0x52,0x20,0x03,0x40,0x50,0x51,0x07,0x70,0x04, //0xC5
+	0x70,0x61, //0xC5
+	0x00,0x01,0x10,0x05,0x20,0x00,0x20,0x20,0x20,0x61,0x40,0x13, //0xC6
+	0x52,0x07, //0xC6
+	0x00,0x34,0x10,0x61,0x20,0x12,0x20,0x51,0x30,0x31,0x30,0x70, //0xC7
+	0x51,0x07,0x70,0x14, //0xC7
+	0x01,0x11,0x02,0x50,0x20,0x20,0x30,0x10,0x40,0x21,0x50,0x41, //0xC8
+	0x60,0x02,0x70,0x22, //0xC8
+	0x00,0x40,0x10,0x41,0x30,0x50,0x41,0x41,0x61,0x50, //0xC9
+	0x10,0x00,0x20,0x01,0x31,0x00, //0xCA
+	0x02,0x52,0x31,0x43,0x50,0x40,0x50,0x60,0x70,0x52, //0xCB
+	0x00,0x05,0x10,0x02,0x10,0x41,0x10,0x70,0x20,0x07,0x30,0x03, //0xCC
+	0x40,0x10,0x40,0x70,0x50,0x43,0x60,0x25,0x70,0x04,0x70,0x61, //0xCC
+	0x00,0x04,0x10,0x02,0x10,0x70,0x20,0x52,0x30,0x16,0x40,0x03, //0xCD
+	0x50,0x01,0x50,0x30,0x50,0x61,0x60,0x14,0x70,0x02, //0xCD
+	0x00,0x25,0x10,0x04,0x11,0x61,0x20,0x01,0x30,0x23,0x40,0x03, //0xCE
+	0x50,0x00, //0xCE
+	0x00,0x01,0x00,0x42,0x10,0x02,0x10,0x61,0x20,0x01,0x20,0x30, //0xCF
+	0x30,0x41,0x40,0x52,0x50,0x70, //0xCF
+	0x10,0x00,0x20,0x02,0x30,0x13,0x40,0x41,0x50,0x01,0x50,0x42, //0xD0
+	0x60,0x10,0x60,0x61,0x70,0x21,0x70,0x70, //0xD0
+	0x00,0x00,0x10,0x10,0x30,0x00,0x40,0x11,0x50,0x20,0x60,0x00, //0xD1
+	0x70,0x02, //0xD1
+	0x31,0x52,0x50,0x24,0x60,0x11,0x61,0x61,0x70,0x00, //0xD2
+	0x00,0x01,0x00,0x43,0x10,0x25,0x20,0x03,0x20,0x50,0x20,0x70, //0xD3
+	0x30,0x01,0x30,0x43,0x40,0x00,0x40,0x23,0x40,0x70,0x50,0x05, //0xD3
+	0x60,0x03,0x60,0x50,0x70,0x00,0x70,0x30, //0xD3
+	0x00,0x16,0x10,0x06,0x20,0x02,0x20,0x42,0x31,0x20,0x41,0x00, //0xD4
+	0x00,0x07,0x11,0x21,0x11,0x70, //0xD5
+	0x00,0x07,0x11,0x00,0x10,0x41,0x21,0x40,0x50,0x52,0x60,0x32, //0xD6
+	0x70,0x10, //0xD6
+	0x00,0x07,0x10,0x01,0x10,0x51,0x20,0x11,0x21,0x60,0x40,0x00, //0xD7
+	0x50,0x04,0x60,0x11,0x60,0x51,0x70,0x30,0x70,0x61, //0xD7
+	0x00,0x07,0x11,0x21,0x11,0x70,0x30,0x30,0x70,0x00, //0xD8
+	0x00,0x05,0x12,0x00,0x10,0x42,0x20,0x43,0x30,0x40, //0xD9
+	0x00,0x43,0x10,0x01,0x10,0x70,0x20,0x11,0x20,0x40,0x30,0x14, //0xDA
+	0x40,0x11,0x40,0x52,0x50,0x51, //0xDA
+	0x00,0x41,0x10,0x01,0x20,0x22,0x30,0x43,0x40,0x01,0x50,0x04, //0xDB
+	0x60,0x02,0x61,0x41,0x60,0x70,0x70,0x10, //0xDB
+	0x40,0x01,0x50,0x22,0x60,0x52,0x70,0x00,0x70,0x30,0x70,0x70, //0xDC
+	0x70,0x01, //0xDD
+	0x61,0x10, //0xDE
+	0x30,0x70,0x40,0x61,0x50,0x42,0x60,0x61,0x70,0x70, //0xDF
+	0x10,0x61,0x20,0x43,0x30,0x06,0x40,0x02,0x40,0x52,0x50,0x24, //0xE0
+	0x60,0x12,0x70,0x00, //0xE0
+	0x00,0x00,0x00,0x25,0x10,0x05,0x10,0x70,0x20,0x03,0x20,0x52, //0xE1
+	0x30,0x15,0x40,0x03, //0xE1
+	0x00,0x01,0x00,0x43,0x10,0x04,0x20,0x01, //0xE2
+	0x00,0x00, //0xE3
+	0x60,0x70,0x70,0x42, //0xE4
+	0x50,0x10,0x60,0x01,0x70,0x20, //0xE5
+	0x00,0x31,0x10,0x51,0x20,0x70, //0xE6
+	0x00,0x12,0x10,0x33,0x20,0x00,0x20,0x43,0x30,0x02,0x31,0x50, //0xE7
+	0x40,0x21,0x50,0x43,0x61,0x40,0x60,0x70, //0xE7
+	0x20,0x00,0x30,0x02,0x40,0x12,0x50,0x41,0x60,0x00,0x60,0x51, //0xE8
+	0x70,0x13, //0xE8
+	0x00,0x01,0x00,0x42,0x10,0x04,0x10,0x60,0x21,0x11,0x21,0x40, //0xE9
+	0x00,0x00,0x60,0x70,0x70,0x51, //0xEA
+	0x30,0x61,0x40,0x42,0x50,0x22,0x50,0x70,0x60,0x02,0x60,0x52, //0xEB
+	0x70,0x01,0x70,0x34, //0xEB
+	0x00,0x52,0x10,0x25,0x21,0x07,0x40,0x16,0x50,0x06,0x60,0x03, //0xEC
+	0x70,0x02, //0xEC
+	0x04,0x07,0x50,0x61, //0xED
+	0x00,0x04,0x10,0x05,0x20,0x04,0x20,0x61,0x31,0x05,0x41,0x70, //0xEE
+	0x50,0x04, //0xEE
+	0x00,0x04,0x11,0x20,0x10,0x42,0x20,0x00,0x20,0x43,0x30,0x31, //0xEF
+	0x40,0x00,0x40,0x61,0x50,0x02,0x60,0x10,0x60,0x41,0x70,0x22, //0xEF
+	0x70,0x61, //0xEF
+	0x21,0x00,0x30,0x21,0x40,0x23,0x50,0x00,0x51,0x40,0x50,0x70, //0xF0
+	0x60,0x60,0x70,0x01,0x70,0x50,0x70,0x70, //0xF0
+	0x50,0x00,0x60,0x20,0x60,0x40,0x70,0x42, //0xF1
+	0x00,0x40, //0xF2
+	0x01,0x00,0x00,0x22,0x10,0x33,0x20,0x31,0x21,0x61,0x40,0x70, //0xF3
+	0x00,0x31,0x20,0x11,0x30,0x21,0x40,0x12,0x60,0x30,0x70,0x31, //0xF4
+	0x00,0x70, //0xF5
+	0x10,0x00,0x10,0x20,0x20,0x30,0x33,0x10,0x70,0x01, //0xF6
+	0x70,0x70, //0xF7
+	0x50,0x61,0x60,0x23,0x70,0x02,0x70,0x70, //0xF8
+	0x30,0x52,0x40,0x13,0x50,0x00,0x50,0x61,0x60,0x34,0x70,0x07, //0xF9
+	0x10,0x43,0x20,0x13,0x30,0x70,0x40,0x25,0x51,0x07,0x70,0x05, //0xFA
+	0x00,0x03,0x10,0x52,0x20,0x25,0x31,0x07,0x50,0x04,0x60,0x00, //0xFB
+	0x00,0x03,0x10,0x04,0x20,0x01,0x20,0x33,0x30,0x02,0x30,0x43, //0xFC
+	0x40,0x01,0x41,0x70, //0xFC
+	0x30,0x00,0x40,0x02,0x50,0x13,0x60,0x00,0x60,0x33,0x70,0x20, //0xFD
+	0x70,0x52, //0xFD
+	0x07,0x40,0x70,0x00, //0xFE
+	0x00,0x21, //0xFF
+};
+
+const unsigned short FontSpanIndex[257]={
+	0,0,2,4,10,16,18,24,26,32,38,48,62,76,88,98,
+	114,128,140,156,166,170,182,198,204,214,222,242,256,272,286,304,
+	322,322,326,330,346,372,386,406,412,418,424,438,444,450,452,454,
+	466,474,480,492,506,522,536,550,558,572,586,590,598,612,616,630,
+	642,666,680,694,704,712,722,730,744,754,756,762,780,784,800,818,
+	826,836,850,862,876,880,886,896,910,932,944,958,976,994,1016,1038,
+	1048,1060,1072,1084,1088,1090,1098,1106,1110,1118,1120,1134,1150,1164,1170,1192,
+	1196,1214,1228,1242,1268,1288,1310,1314,1326,1354,1376,1398,1418,1422,1426,1446,
+	1472,1478,1498,1524,1544,1582,1604,1620,1634,1656,1682,1686,1698,1704,1722,1736,
+	1752,1754,1760,1784,1816,1844,1868,1878,1906,1930,1950,1960,1966,1976,1986,1994,
+	2016,2044,2062,2086,2096,2120,2138,2168,2194,2198,2208,2210,2226,2240,2254,2264,
+	2274,2288,2312,2336,2368,2396,2422,2442,2462,2486,2498,2508,2526,2546,2566,2590,
+	2620,2632,2646,2674,2694,2720,2734,2748,2764,2780,2790,2796,2806,2830,2852,2866,
+	2884,2904,2918,2928,2960,2972,2978,2992,3014,3024,3034,3052,3072,3084,3086,3088,
+	3098,3114,3130,3138,3140,3144,3150,3156,3176,3190,3202,3208,3224,3238,3242,3256,
+	3282,3302,3310,3312,3324,3336,3338,3348,3350,3358,3370,3382,3394,3410,3424,3428,
+	3430,
+};
@@ -1,10 +1,14 @@
 //カラーグラフィックライブラリ
 
+#include <string.h>
 #include "graphlib.h"
 #include "LCDdriver.h"
 
 unsigned short palette[256];
+static unsigned char palettergb[256][3]; //set_palette()で設定した色（青、赤、緑）
 extern const unsigned char FontData[];
+extern const unsigned char FontSpan[]; //フォントの点の並びを長方形に分けた表（fontspan.c）
+extern const unsigned short FontSpanIndex[];
 /*
 const unsigned char __attribute__((weak)) FontData[256*8]={
 //フォントデータ、キャラクタコード順に8バイトずつ、上位ビットが左
@@ -272,87 +276,312 @@ volatile unsigned short delaytimerflag;
 
 void set_palette(unsigned char n,unsigned char b,unsigned char r,unsigned char g){
 //グラフィック用カラーパレット設定
-	palette[n]=((r>>3)<<11)+((g>>2)<<5)+(b>>3);
+	palette[n]=LCD_RGB(r,g,b); //液晶への送信形式に合わせて変換しておく
+	palettergb[n][0]=b;
+	palettergb[n][1]=r;
+	palettergb[n][2]=g;
+}
+
+// クリッピング範囲
+// 各描画関数は描画の最初に1回だけ範囲と比べて描画する部分を決め、範囲の外側には描画しない
+// pushclip()で範囲を狭め、popclip()で元に戻す（CLIP_DEPTH段まで）。タイルマップには影響しない
+#ifndef CLIP_DEPTH
+#define CLIP_DEPTH 8
+#endif
+typedef struct {
+	short x1,y1; //左上
+	short x2,y2; //右下+1
+} _Clip;
+static _Clip clip={0,0,X_RES,Y_RES}; //現在のクリッピング範囲
+static _Clip clipstack[CLIP_DEPTH];
+static int clipsp;
+
+void pushclip(int x,int y,int w,int h){
+	//現在のクリッピング範囲を保存し、(x,y)から横w*縦hの範囲との重なりを新しい範囲にする
+	if(clipsp>=CLIP_DEPTH) return;
+	clipstack[clipsp++]=clip;
+	if(x>clip.x1) clip.x1=x;
+	if(y>clip.y1) clip.y1=y;
+	if(x+w<clip.x2) clip.x2=x+w;
+	if(y+h<clip.y2) clip.y2=y+h;
+	if(clip.x2<clip.x1) clip.x2=clip.x1;
+	if(clip.y2<clip.y1) clip.y2=clip.y1;
+}
+
+void popclip(void){
+	//pushclip()で保存したクリッピング範囲に戻す
+	if(clipsp>0) clip=clipstack[--clipsp];
+}
+
+static int clipbox(int *x,int *y,int *w,int *h)
+//(*x,*y)から横*w*縦*hの範囲をクリッピング範囲で切り取る
+//描画する部分がなければ0を返す
+{
+	if(*x<clip.x1){
+		*w-=clip.x1-*x;
+		*x=clip.x1;
+	}
+	if(*y<clip.y1){
+		*h-=clip.y1-*y;
+		*y=clip.y1;
+	}
+	if(*x+*w>clip.x2) *w=clip.x2-*x;
+	if(*y+*h>clip.y2) *h=clip.y2-*y;
+	return *w>0 && *h>0;
 }
 
 void pset(int x,int y,unsigned char c)
 // (x,y)の位置にカラーパレット番号cで点を描画
 {
-	if(x>=0 && x<X_RES && y>=0 && y<Y_RES)
+	if(x>=clip.x1 && x<clip.x2 && y>=clip.y1 && y<clip.y2)
 		drawPixel(x,y,palette[c]);
 }
 
+static void putpixels(int x,int y,const unsigned short *c,int n)
+// (x,y)から横方向にn画素分、画素色の配列cを出力（画面内であること）
+{
+	static unsigned char lcdbuf[LCD_PIXBYTES(X_RES)];
+	LCD_TxBegin();
+	LCD_TxWindow(x,y,n,1);
+	LCD_TxQueue(lcdbuf,LCD_PackPixels(lcdbuf,c,n));
+	LCD_TxEnd();
+}
+
 void putbmpmn(int x,int y,unsigned char m,unsigned char n,const unsigned char bmp[])
 // 横m*縦nドットのキャラクターを座標x,yに表示
 // unsigned char bmp[m*n]配列に、単純にカラー番号を並べる
 // カラー番号が0の部分は透明色として扱う
 {
-	int i,j;
-	int skip;
+	int i,j,k,x1,y1,w,h;
+	unsigned short pix[X_RES];
 	const unsigned char *p;
-	if(x<=-m || x>X_RES || y<=-n || y>=Y_RES) return; //画面外
-	if(y<0){ //画面上部に切れる場合
-		i=0;
-		p=bmp-y*m;
-	}
-	else{
-		i=y;
-		p=bmp;
-	}
-	for(;i<y+n;i++){
-		if(i>=Y_RES) return; //画面下部に切れる場合
-		if(x<0){ //画面左に切れる場合は残る部分のみ描画
-			j=0;
-			p+=-x;
-		}
-		else{
-			j=x;
+	//クリッピング範囲に収まる部分のみ描画
+	x1=x;
+	y1=y;
+	w=m;
+	h=n;
+	if(!clipbox(&x1,&y1,&w,&h)) return;
+	LCD_TxBegin();
+	for(i=y1;i<y1+h;i++){
+		p=bmp+(i-y)*m+(x1-x);
+		k=0;
+		for(j=x1;j<x1+w;j++){
+			if(*p!=0){ //カラー番号が0の場合、透明として処理
+				pix[k++]=palette[*p];
+			}
+			else if(k){
+				putpixels(j-k,i,pix,k);
+				k=0;
+			}
+			p++;
 		}
-		skip=1;
-		for(;j<x+m;j++){
-			if(j>=X_RES){ //画面右に切れる場合
-				p+=x+m-j;
-				break;
+		if(k) putpixels(j-k,i,pix,k);
+	}
+	LCD_TxEnd();
+}
+
+
+void putrle(int x,int y,const unsigned char *rle)
+// RLE形式のスプライト（tools/mkrle.cで作成）を座標x,yに表示
+// 透明の画素を挟まずに続く不透明の並びをまとめて、1つのウィンドウで送信する
+{
+	int i,j,js,k,l,m,n,c,x1,y1,w,h,a,b;
+	unsigned short pix[255];
+	const unsigned char *p;
+	m=rle[0];
+	n=rle[1];
+	rle+=2;
+	//クリッピング範囲に収まる部分のみ描画。範囲外の行と並びは読み飛ばす
+	x1=x;
+	y1=y;
+	w=m;
+	h=n;
+	if(!clipbox(&x1,&y1,&w,&h)) return;
+	LCD_TxBegin();
+	for(i=y;i<y1+h;i++){
+		j=x;
+		js=0;
+		k=0; //pixに溜めた画素数
+		while(1){
+			l=*rle++; //透明の画素数
+			if(l && k){
+				putpixels(js,i,pix,k);
+				k=0;
 			}
-			if(*p!=0){ //カラー番号が0の場合、透明として処理
-				if(skip){
-					LCD_SetCursor(j,i);
-					skip=0;
+			j+=l;
+			c=*rle++; //不透明の画素数
+			if(c==0) break; //行の終わり
+			l=c&0x7f;
+			//並びのうちクリッピング範囲内の部分a〜b-1
+			a=j<x1?x1:j;
+			b=j+l>x1+w?x1+w:j+l;
+			if(i>=y1 && a<b){
+				if(k==0) js=a;
+				if(c&0x80){
+					for(;a<b;a++) pix[k++]=palette[*rle]; //同じ色の並び
+				}
+				else{
+					for(p=rle+(a-j);a<b;a++) pix[k++]=palette[*p++];
 				}
-				LCD_WriteData2(palette[*p]);
 			}
-			else skip=1;
-			p++;
+			j+=l;
+			rle+=(c&0x80)?1:l;
 		}
+		if(k) putpixels(js,i,pix,k);
 	}
+	LCD_TxEnd();
 }
 
+// QOI形式の画像のデコード状態
+typedef struct {
+	const unsigned char *p; //次に読むデータ
+	unsigned char r,g,b,a; //直前の画素
+	int run; //直前の画素を繰り返す残りの数
+	unsigned short color; //直前の画素の画素色
+	unsigned char index[64][4]; //最近の画素の表
+} _Qoi;
 
-void LCD_continuous_output(unsigned short x,unsigned short y,unsigned short color,int n);
+static inline unsigned short qoipixel(_Qoi *q)
+// QOI形式のデータから次の1画素をデコードして画素色を返す
+{
+	unsigned char op,d;
+	const unsigned char *p;
+	int dg;
+	if(q->run){
+		q->run--;
+		return q->color;
+	}
+	p=q->p;
+	op=*p++;
+	if(op==0xfe){ //QOI_OP_RGB
+		q->r=p[0];
+		q->g=p[1];
+		q->b=p[2];
+		p+=3;
+	}
+	else if(op==0xff){ //QOI_OP_RGBA
+		q->r=p[0];
+		q->g=p[1];
+		q->b=p[2];
+		q->a=p[3];
+		p+=4;
+	}
+	else switch(op>>6){
+	case 0: //QOI_OP_INDEX
+		q->r=q->index[op][0];
+		q->g=q->index[op][1];
+		q->b=q->index[op][2];
+		q->a=q->index[op][3];
+		break;
+	case 1: //QOI_OP_DIFF
+		q->r+=((op>>4)&3)-2;
+		q->g+=((op>>2)&3)-2;
+		q->b+=(op&3)-2;
+		break;
+	case 2: //QOI_OP_LUMA
+		d=*p++;
+		dg=(op&0x3f)-32;
+		q->r+=dg-8+(d>>4);
+		q->g+=dg;
+		q->b+=dg-8+(d&15);
+		break;
+	default: //QOI_OP_RUN 直前の画素をさらにrun画素繰り返す
+		q->run=op&0x3f;
+		q->p=p;
+		return q->color;
+	}
+	q->p=p;
+	d=(q->r*3+q->g*5+q->b*7+q->a*11)&63;
+	q->index[d][0]=q->r;
+	q->index[d][1]=q->g;
+	q->index[d][2]=q->b;
+	q->index[d][3]=q->a;
+	q->color=LCD_RGB(q->r,q->g,q->b);
+	return q->color;
+}
+
+void putqoi(int x,int y,const unsigned char *qoi)
+// QOI形式のフルカラー画像（tools/mkqoi.cで作成）を座標x,yに表示
+// 画像全体をRAMに展開せず、1ラインずつデコードして1つのウィンドウに送信する
+// 2つのバッファを交互に使い、一方のDMA送信中に次のラインをデコードする
+// アルファ値は無視する
+{
+	int i,j,k,n,m,x1,y1,w,h,carry;
+	unsigned short *cp;
+	static _Qoi q;
+	static unsigned short pix[X_RES+1];
+	static unsigned char linebuf[2][LCD_PIXBYTES(X_RES+1)];
+	if(qoi[0]!='q' || qoi[1]!='o' || qoi[2]!='i' || qoi[3]!='f') return;
+	m=(qoi[4]<<24)|(qoi[5]<<16)|(qoi[6]<<8)|qoi[7];
+	n=(qoi[8]<<24)|(qoi[9]<<16)|(qoi[10]<<8)|qoi[11];
+	//クリッピング範囲に収まる部分のみ送信。範囲外の画素もデコードは必要なので読み捨てる
+	x1=x;
+	y1=y;
+	w=m;
+	h=n;
+	if(!clipbox(&x1,&y1,&w,&h)) return;
+	q.p=qoi+14;
+	q.r=q.g=q.b=0;
+	q.a=255;
+	q.run=0;
+	q.color=LCD_RGB(0,0,0);
+	memset(q.index,0,sizeof(q.index));
+	for(i=y;i<y1;i++){
+		for(j=0;j<m;j++) qoipixel(&q);
+	}
+	carry=0;
+	k=0;
+	LCD_TxBegin();
+	LCD_TxWindow(x1,y1,w,h);
+	for(;i<y1+h;i++){
+		for(j=x;j<x1;j++) qoipixel(&q);
+		cp=pix+carry;
+		for(j=0;j<w;j++) *cp++=qoipixel(&q);
+		for(j=x1+w;j<x+m;j++) qoipixel(&q);
+		j=cp-pix;
+#if LCD_COLORMODE == LCD_COLOR12
+		//2画素を3バイトに詰めるので、最終ライン以外は奇数個目の画素を次のラインに回す
+		//最終ラインは前のラインから回された画素も含めて全て送る
+		carry=(i<y1+h-1)?(j&1):0;
+		j-=carry;
+#endif
+		LCD_TxDMA(linebuf[k],LCD_PackPixels(linebuf[k],pix,j));
+		if(carry) pix[0]=pix[j];
+		k^=1;
+	}
+	LCD_TxEnd();
+}
+
+static void putrun(int x,int y,int w,int h,unsigned short color)
+// (x,y)から横w*縦hの範囲を画素色colorで塗りつぶし（クリッピング範囲外の部分は切り取る）
+// 1画素の場合はDMAを使わずにそのまま送信する
+{
+	unsigned char b[LCD_PIXBYTES(1)];
+	if(!clipbox(&x,&y,&w,&h)) return;
+	if(w==1 && h==1){
+		LCD_TxBegin();
+		LCD_TxWindow(x,y,1,1);
+		LCD_TxQueue(b,LCD_PackPixels(b,&color,1));
+		LCD_TxEnd();
+	}
+	else LCD_Fill(x,y,w,h,color);
+}
 
 // 縦m*横nドットのキャラクター消去
 // カラー0で塗りつぶし
 void clrbmpmn(int x,int y,unsigned char m,unsigned char n)
 {
-	int i,j,k;
-	if(x<=-m || x>X_RES || y<=-n || y>=Y_RES) return; //画面外
-	if(y<0) i=0; //画面上部に切れる場合
-	else i=y;
-	if(x<0) j=0; //画面左に切れる場合は残る部分のみ描画
-	else j=x;
-	if(x+m>=X_RES) k=X_RES-j; //画面右に切れる場合
-	else k=x+m-j;
-	for(;i<y+n;i++){
-		if(i>=Y_RES) return; //画面下部に切れる場合
-		LCD_continuous_output(j,i,0,k);
-	}
+	putrun(x,y,m,n,0);
 }
 
 void gline(int x1,int y1,int x2,int y2,unsigned char c)
 // (x1,y1)-(x2,y2)にカラーパレット番号cで線分を描画
+// 同じ行（縦長の線では同じ列）に続く点をまとめて1回で塗りつぶし、
+// 線分全体を1つのトランザクションで送信する
 {
-	int sx,sy,dx,dy,i;
+	int sx,sy,dx,dy,i,k;
 	int e;
+	unsigned short color;
 
 	if(x2>x1){
 		dx=x2-x1;
@@ -370,12 +599,20 @@ void gline(int x1,int y1,int x2,int y2,unsigned char c)
 		dy=y1-y2;
 		sy=-1;
 	}
+	color=palette[c];
+	LCD_TxBegin();
 	if(dx>=dy){
 		e=-dx;
+		k=0; //同じ行に続く点の数
 		for(i=0;i<=dx;i++){
-			pset(x1,y1,c);
-			x1+=sx;
+			k++;
 			e+=dy*2;
+			if(e>=0 || i==dx){
+				if(sx>0) putrun(x1-k+1,y1,k,1,color);
+				else putrun(x1,y1,k,1,color);
+				k=0;
+			}
+			x1+=sx;
 			if(e>=0){
 				y1+=sy;
 				e-=dx*2;
@@ -384,50 +621,70 @@ void gline(int x1,int y1,int x2,int y2,unsigned char c)
 	}
 	else{
 		e=-dy;
+		k=0; //同じ列に続く点の数
 		for(i=0;i<=dy;i++){
-			pset(x1,y1,c);
-			y1+=sy;
+			k++;
 			e+=dx*2;
+			if(e>=0 || i==dy){
+				if(sy>0) putrun(x1,y1-k+1,1,k,color);
+				else putrun(x1,y1,1,k,color);
+				k=0;
+			}
+			y1+=sy;
 			if(e>=0){
 				x1+=sx;
 				e-=dy*2;
 			}
 		}
 	}
+	LCD_TxEnd();
 }
 void hline(int x1,int x2,int y,unsigned char c)
 // (x1,y)-(x2,y)への水平ラインを高速描画
 {
 	int temp;
 
-	if(y<0 || y>=Y_RES) return;
 	if(x1>x2){
 		temp=x1;
 		x1=x2;
 		x2=temp;
 	}
-	if(x2<0 || x1>=X_RES) return;
-	if(x1<0) x1=0;
-	if(x2>=X_RES) x2=X_RES-1;
-	LCD_continuous_output(x1,y,palette[c],x2-x1+1);
+	putrun(x1,y,x2-x1+1,1,palette[c]);
+}
+
+static void circlerun(int x0,int y0,int x,int ya,int yb,unsigned short color)
+// circle()の8つの八分円について、xが同じでyがyaからybまでの点の並びをそれぞれ塗りつぶす
+{
+	int n;
+	n=yb-ya+1;
+	putrun(x0+x,y0-yb,1,n,color);
+	putrun(x0+x,y0+ya,1,n,color);
+	putrun(x0-x,y0-yb,1,n,color);
+	putrun(x0-x,y0+ya,1,n,color);
+	putrun(x0-yb,y0-x,n,1,color);
+	putrun(x0+ya,y0-x,n,1,color);
+	putrun(x0-yb,y0+x,n,1,color);
+	putrun(x0+ya,y0+x,n,1,color);
 }
 
 void circle(int x0,int y0,unsigned int r,unsigned char c)
 // (x0,y0)を中心に、半径r、カラーパレット番号cの円を描画
+// xが変わらずに続く点をまとめて縦または横の並びとして塗りつぶす
 {
-	int x,y,f;
+	int x,y,f,ys;
+	unsigned short color;
 	x=r;
 	y=0;
 	f=-2*r+3;
+	ys=0; //xが同じ点の並びの始まりのy
+	color=palette[c];
+	LCD_TxBegin();
 	while(x>=y){
-		pset(x0-x,y0-y,c);
-		pset(x0-x,y0+y,c);
-		pset(x0+x,y0-y,c);
-		pset(x0+x,y0+y,c);
-		pset(x0-y,y0-x,c);
-		pset(x0-y,y0+x,c);
-		pset(x0+y,y0-x,c);
-		pset(x0+y,y0+x,c);
+		if(f>=0 || y+1>x){
+			//このyで並びが終わる
+			circlerun(x0,y0,x,ys,y,color);
+			ys=y+1;
+		}
 		if(f>=0){
 			x--;
 			f-=x*4;
@@ -435,9 +692,11 @@ void circle(int x0,int y0,unsigned int r,unsigned char c)
 		y++;
 		f+=y*4+2;
 	}
+	LCD_TxEnd();
 }
 void boxfill(int x1,int y1,int x2,int y2,unsigned char c)
 // (x1,y1),(x2,y2)を対角線とするカラーパレット番号cで塗られた長方形を描画
+// 長方形全体を1つのウィンドウにして一度に送信する
 {
 	int temp;
 	if(x1>x2){
@@ -445,31 +704,44 @@ void boxfill(int x1,int y1,int x2,int y2,unsigned char c)
 		x1=x2;
 		x2=temp;
 	}
-	if(x2<0 || x1>=X_RES) return;
 	if(y1>y2){
 		temp=y1;
 		y1=y2;
 		y2=temp;
 	}
-	if(y2<0 || y1>=Y_RES) return;
-	if(y1<0) y1=0;
-	if(y2>=Y_RES) y2=Y_RES-1;
-	while(y1<=y2){
-		hline(x1,x2,y1++,c);
-	}
+	putrun(x1,y1,x2-x1+1,y2-y1+1,palette[c]);
 }
+
+static short circlespan[Y_RES]; //circlefill()で各ラインの中心から端までの幅、-1は描画なし
+
+static void setcirclespan(int y,int w)
+// circlefill()でラインyの幅をw以上にする
+{
+	if(y<clip.y1 || y>=clip.y2) return;
+	if(circlespan[y]<w) circlespan[y]=w;
+}
+
 void circlefill(int x0,int y0,unsigned int r,unsigned char c)
 // (x0,y0)を中心に、半径r、カラーパレット番号cで塗られた円を描画
+// 先に各ラインの幅を求めてから、上から順に1ラインずつ1回だけ描画する
+// 同じ幅のラインが続く場合は1つのウィンドウにまとめる
 {
-	int x,y,f;
+	int x,y,f,y1,y2;
+	unsigned short color;
+	y1=y0-(int)r;
+	y2=y0+(int)r;
+	if(y1<clip.y1) y1=clip.y1;
+	if(y2>=clip.y2) y2=clip.y2-1;
+	if(y1>y2) return;
+	for(y=y1;y<=y2;y++) circlespan[y]=-1;
 	x=r;
 	y=0;
 	f=-2*r+3;
 	while(x>=y){
-		hline(x0-x,x0+x,y0-y,c);
-		hline(x0-x,x0+x,y0+y,c);
-		hline(x0-y,x0+y,y0-x,c);
-		hline(x0-y,x0+y,y0+x,c);
+		setcirclespan(y0-y,x);
+		setcirclespan(y0+y,x);
+		setcirclespan(y0-x,y);
+		setcirclespan(y0+x,y);
 		if(f>=0){
 			x--;
 			f-=x*4;
@@ -477,126 +749,713 @@ void circlefill(int x0,int y0,unsigned int r,unsigned char c)
 		y++;
 		f+=y*4+2;
 	}
+	color=palette[c];
+	LCD_TxBegin();
+	while(y1<=y2){
+		x=circlespan[y1];
+		for(y=y1+1;y<=y2 && circlespan[y]==x;y++) ;
+		if(x>=0) putrun(x0-x,y1,x*2+1,y-y1,color);
+		y1=y;
+	}
+	LCD_TxEnd();
+}
+
+static short polyspan[Y_RES][2]; //polygonfill()で各ラインの左端と右端、左端>右端は描画なし
+
+static void setpolyspan(int y,int xa,int xb)
+// polygonfill()でラインyの範囲をxa〜xbを含むように広げる
+// クリッピング範囲の外側は左右1画素外までに縮めておく
+{
+	if(y<clip.y1 || y>=clip.y2) return;
+	if(xa<clip.x1) xa=clip.x1-1;
+	if(xb>=clip.x2) xb=clip.x2;
+	if(polyspan[y][0]>xa) polyspan[y][0]=xa;
+	if(polyspan[y][1]<xb) polyspan[y][1]=xb;
+}
+
+static void polyedge(int x1,int y1,int x2,int y2)
+// 辺(x1,y1)-(x2,y2)がgline()と同じ点を通るように、各ラインの範囲をpolyspanに加える
+{
+	int sx,sy,dx,dy,i,xs,e;
+
+	if(x2>x1){
+		dx=x2-x1;
+		sx=1;
+	}
+	else{
+		dx=x1-x2;
+		sx=-1;
+	}
+	if(y2>y1){
+		dy=y2-y1;
+		sy=1;
+	}
+	else{
+		dy=y1-y2;
+		sy=-1;
+	}
+	if(dx>=dy){
+		e=-dx;
+		xs=x1; //同じ行に続く点の始まり
+		for(i=0;i<=dx;i++){
+			e+=dy*2;
+			if(e>=0 || i==dx){
+				if(sx>0) setpolyspan(y1,xs,x1);
+				else setpolyspan(y1,x1,xs);
+				xs=x1+sx;
+			}
+			x1+=sx;
+			if(e>=0){
+				y1+=sy;
+				e-=dx*2;
+			}
+		}
+	}
+	else{
+		e=-dy;
+		for(i=0;i<=dy;i++){
+			setpolyspan(y1,x1,x1);
+			e+=dx*2;
+			y1+=sy;
+			if(e>=0){
+				x1+=sx;
+				e-=dy*2;
+			}
+		}
+	}
+}
+
+void polygonfill(int n,const int *xy,unsigned char c)
+// n個の頂点(xy[0],xy[1])、(xy[2],xy[3])…を順に結んだ凸多角形を、カラーパレット番号cで塗りつぶし
+// 各辺をgline()と同じ点で辿って各ラインの左端と右端を求め、上から順に1ラインずつ1回だけ描画する
+// 左右の端が同じラインが続く場合は1つのウィンドウにまとめる
+// 凸でない多角形は、各ラインの一番左の点から一番右の点までを塗る
+{
+	int i,x,y,y1,y2;
+	unsigned short color;
+	if(n<1) return;
+	y1=y2=xy[1];
+	for(i=1;i<n;i++){
+		if(xy[i*2+1]<y1) y1=xy[i*2+1];
+		if(xy[i*2+1]>y2) y2=xy[i*2+1];
+	}
+	if(y1<clip.y1) y1=clip.y1;
+	if(y2>=clip.y2) y2=clip.y2-1;
+	if(y1>y2) return;
+	for(y=y1;y<=y2;y++){
+		polyspan[y][0]=clip.x2;
+		polyspan[y][1]=clip.x1-1;
+	}
+	for(i=0;i<n-1;i++) polyedge(xy[i*2],xy[i*2+1],xy[i*2+2],xy[i*2+3]);
+	polyedge(xy[i*2],xy[i*2+1],xy[0],xy[1]);
+	color=palette[c];
+	LCD_TxBegin();
+	while(y1<=y2){
+		x=polyspan[y1][0];
+		i=polyspan[y1][1];
+		for(y=y1+1;y<=y2 && polyspan[y][0]==x && polyspan[y][1]==i;y++) ;
+		if(x<=i) putrun(x,y1,i-x+1,y-y1,color);
+		y1=y;
+	}
+	LCD_TxEnd();
+}
+
+void trianglefill(int x1,int y1,int x2,int y2,int x3,int y3,unsigned char c)
+// (x1,y1)、(x2,y2)、(x3,y3)を頂点とする三角形をカラーパレット番号cで塗りつぶし
+{
+	int xy[6];
+	xy[0]=x1;
+	xy[1]=y1;
+	xy[2]=x2;
+	xy[3]=y2;
+	xy[4]=x3;
+	xy[5]=y3;
+	polygonfill(3,xy,c);
+}
+
+// グリフキャッシュ
+// 文字番号と文字色・背景色の組み合わせごとに、液晶への送信形式に展開済みの文字画像を保持する
+// GLYPHCACHE_WAYS個ずつの組に分け、組の中で最も長く使われていないものを入れ替える
+// GLYPHCACHE_SIZEを0にするとキャッシュを使わず、毎回展開する（1文字分のメモリのみ使用）
+#ifndef GLYPHCACHE_SIZE
+#define GLYPHCACHE_SIZE 8192 //グリフキャッシュに使うメモリのバイト数
+#endif
+#define GLYPH_LINEBYTES LCD_PIXBYTES(FONTSIZE) //展開済みの文字画像の1ライン分のバイト数
+#define GLYPH_BYTES (GLYPH_LINEBYTES*FONTSIZE) //展開済みの文字画像1文字分のバイト数
+#define GLYPHCACHE_WAYS 4
+#if GLYPHCACHE_SIZE/GLYPH_BYTES/GLYPHCACHE_WAYS>0
+#define GLYPHCACHE_SETS (GLYPHCACHE_SIZE/GLYPH_BYTES/GLYPHCACHE_WAYS)
+#else
+#define GLYPHCACHE_SETS 1
+#endif
+typedef struct {
+	unsigned int color; //文字色<<16|背景色、液晶の画素色
+	unsigned int used; //最後に使用した時刻、0の場合は未使用
+	unsigned char n; //文字番号
+} _Glyphtag;
+
+// 文字画像の展開
+// フォントの1ラインを4ビットずつに分け、4ビットの値ごとに送信形式に変換済みの4*LCD_SCALE画素分の
+// データを表glyphlutから複写する。表は文字色と背景色の組み合わせごとにGLYPHLUT_NUM組まで保持し、
+// どれにもない組み合わせの場合のみ順に作り直す
+#ifndef GLYPHLUT_NUM
+#define GLYPHLUT_NUM 4
+#endif
+#define GLYPH_NIBBLEBYTES LCD_PIXBYTES(4*LCD_SCALE) //4ビット分の送信バイト数
+#if GLYPH_NIBBLEBYTES%4==0
+typedef unsigned int _Glyphword; //展開時に1回で書き込む単位
+#else
+typedef unsigned short _Glyphword;
+#endif
+#define GLYPH_NIBBLEWORDS (GLYPH_NIBBLEBYTES/sizeof(_Glyphword))
+static _Glyphword glyphlut[GLYPHLUT_NUM][16][GLYPH_NIBBLEWORDS];
+static unsigned int glyphlutcolor[GLYPHLUT_NUM]; //各表の文字色<<16|背景色
+static unsigned char glyphlutvalid[GLYPHLUT_NUM];
+static unsigned char glyphlutnext; //次に作り直す表
+
+static void expandglyph(_Glyphword *b,unsigned char n,unsigned short c1,unsigned short bc)
+//文字番号nを文字色c1、背景色bc（液晶の画素色）で送信形式に展開してbに書き込む（GLYPH_BYTESバイト）
+{
+	int i,j,k;
+	unsigned int color;
+	unsigned short pix[4*LCD_SCALE];
+	const unsigned char *p;
+	const _Glyphword *l1,*l2;
+	_Glyphword (*lut)[GLYPH_NIBBLEWORDS];
+	color=(c1<<16)|bc;
+	for(k=0;k<GLYPHLUT_NUM;k++){
+		if(glyphlutvalid[k] && glyphlutcolor[k]==color) break;
+	}
+	if(k==GLYPHLUT_NUM){
+		k=glyphlutnext;
+		glyphlutnext=(k+1)%GLYPHLUT_NUM;
+		for(i=0;i<16;i++){
+			for(j=0;j<4*LCD_SCALE;j++) pix[j]=(i<<(j/LCD_SCALE))&8?c1:bc;
+			LCD_PackPixels((unsigned char *)glyphlut[k][i],pix,4*LCD_SCALE);
+		}
+		glyphlutcolor[k]=color;
+		glyphlutvalid[k]=1;
+	}
+	lut=glyphlut[k];
+	p=FontData+n*8;
+	for(i=0;i<8;i++){
+		l1=lut[p[i]>>4];
+		l2=lut[p[i]&15];
+		for(j=0;j<LCD_SCALE;j++){
+			for(k=0;k<GLYPH_NIBBLEWORDS;k++) *b++=l1[k];
+			for(k=0;k<GLYPH_NIBBLEWORDS;k++) *b++=l2[k];
+		}
+	}
+}
+
+#if GLYPHCACHE_SIZE>0
+static _Glyphtag glyphtag[GLYPHCACHE_SETS][GLYPHCACHE_WAYS];
+static _Glyphword glyphimage[GLYPHCACHE_SETS][GLYPHCACHE_WAYS][GLYPH_BYTES/sizeof(_Glyphword)];
+static unsigned int glyphclock; //使用時刻のカウンタ
+
+static const unsigned char *getglyph(unsigned char n,unsigned short c1,unsigned short bc)
+//文字番号n、文字色c1、背景色bc（液晶の画素色）の展開済みの文字画像を返す
+//キャッシュにない場合は展開して登録する。次にgetglyph()を呼ぶまで有効
+{
+	int i,k;
+	unsigned int color;
+	_Glyphtag *t,*victim;
+	color=(c1<<16)|bc;
+	k=(n*31+c1*7+bc)%GLYPHCACHE_SETS;
+	t=glyphtag[k];
+	victim=t;
+	glyphclock++;
+	for(i=0;i<GLYPHCACHE_WAYS;i++,t++){
+		if(t->used && t->color==color && t->n==n){
+			t->used=glyphclock;
+			LCD_STAT(ghit,1);
+			return (const unsigned char *)glyphimage[k][i];
+		}
+		if(t->used<victim->used) victim=t;
+	}
+	LCD_STAT(gmiss,1);
+	victim->used=glyphclock;
+	victim->color=color;
+	victim->n=n;
+	i=victim-glyphtag[k];
+	expandglyph(glyphimage[k][i],n,c1,bc);
+	return (const unsigned char *)glyphimage[k][i];
+}
+#else
+static _Glyphword glyphimage[GLYPH_BYTES/sizeof(_Glyphword)];
+
+static const unsigned char *getglyph(unsigned char n,unsigned short c1,unsigned short bc)
+//文字番号n、文字色c1、背景色bc（液晶の画素色）の文字画像を展開して返す（キャッシュなし）
+//次にgetglyph()を呼ぶまで有効
+{
+	LCD_STAT(gmiss,1);
+	expandglyph(glyphimage,n,c1,bc);
+	return (const unsigned char *)glyphimage;
 }
+#endif
 
 void putfont(int x,int y,unsigned char c,int bc,unsigned char n)
 //8*8ドットのアルファベットフォント表示
+//LCD_SCALE倍に拡大し、FONTSIZE*FONTSIZEドットで表示
 //座標(x,y)、カラーパレット番号c
 //bc:バックグランドカラー、負数の場合無視
 //n:文字番号
 {
-	int i,j;
+	int i,j,k,m,x1,x2,y1,y2;
 	unsigned char d;
-	int skip;
 	unsigned short c1;
 	const unsigned char *p;
-	static unsigned char lcddatabuf[16];
-	unsigned char *lcdbufp;
-	if(x<=-8 || x>=X_RES || y<=-8 || y>=Y_RES) return; //画面外
-	if(y<0){ //画面上部に切れる場合
-		i=0;
-		p=FontData+n*8-y;
-	}
-	else{
-		i=y;
-		p=FontData+n*8;
-	}
+	static unsigned short pix[FONTSIZE*FONTSIZE];
+	static unsigned char lcddatabuf[LCD_PIXBYTES(FONTSIZE*FONTSIZE)];
+	unsigned short *pixp;
+	//クリッピング範囲からはみ出す場合は残る部分のみ描画
+	x1=x;
+	y1=y;
+	x2=FONTSIZE;
+	y2=FONTSIZE;
+	if(!clipbox(&x1,&y1,&x2,&y2)) return;
+	x2+=x1;
+	y2+=y1;
+	p=FontData+n*8;
 	c1=palette[c];
 	if(bc>=0) bc=palette[bc];
-	for(;i<y+8;i++){
-		if(i>=Y_RES) return; //画面下部に切れる場合
-		d=*p++;
-		if(x<0){ //画面左に切れる場合は残る部分のみ描画
-			j=0;
-			d<<=-x;
-		}
-		else{
-			j=x;
-		}
-		if(bc<0){
-			skip=1;
-			for(;j<x+8;j++){
-				if(j>=X_RES){ //画面右に切れる場合
-					break;
-				}
-				if(d&0x80){
-					if(skip){
-						LCD_SetCursor(j,i);
-						skip=0;
-					}
-					LCD_WriteData2(c1);
-				}
-				else skip=1;
-				d<<=1;
+	LCD_TxBegin();
+	if(bc>=0 && x1==x && x2==x+FONTSIZE && y1==y && y2==y+FONTSIZE){
+		//はみ出さない場合は展開済みの文字画像をそのまま送信
+		LCD_TxWindow(x,y,FONTSIZE,FONTSIZE);
+		LCD_TxQueue(getglyph(n,c1,bc),GLYPH_BYTES);
+		LCD_TxEnd();
+		return;
+	}
+	if(bc>=0){
+		//表示される範囲を1つのウィンドウとして、全ラインをまとめて送信
+		//拡大時はフォントの1ラインを横に展開し、縦は展開済みのラインを繰り返す
+		k=x2-x1;
+		pixp=pix;
+		for(i=y1;i<y2;i++){
+			if(i>y1 && (i-y)%LCD_SCALE){
+				memcpy(pixp,pixp-k,k*sizeof(pix[0]));
+				pixp+=k;
+				continue;
 			}
-		}
-		else{
-			LCD_SetCursor(j,i);
-			lcdbufp=lcddatabuf;
-			for(;j<x+8;j++){
-				if(j>=X_RES){ //画面右に切れる場合
-					break;
-				}
-				if(d&0x80){
-					*lcdbufp++=c1>>8;
-					*lcdbufp++=(unsigned char)c1;
+			d=p[(i-y)/LCD_SCALE]<<((x1-x)/LCD_SCALE);
+			m=(x1-x)%LCD_SCALE;
+			for(j=0;j<k;j++){
+				if(d&0x80) *pixp++=c1;
+				else *pixp++=bc;
+				if(++m==LCD_SCALE){
+					m=0;
+					d<<=1;
 				}
-				else{
-					*lcdbufp++=bc>>8;
-					*lcdbufp++=(unsigned char)bc;
-				}
-				d<<=1;
 			}
-			if(lcdbufp!=lcddatabuf) LCD_WriteDataN(lcddatabuf,lcdbufp-lcddatabuf);
 		}
+		LCD_TxWindow(x1,y1,k,y2-y1);
+		LCD_TxQueue(lcddatabuf,LCD_PackPixels(lcddatabuf,pix,pixp-pix));
+		LCD_TxEnd();
+		return;
 	}
+	//背景色なしの場合は、点の並びを長方形に分けた表FontSpanに従い、長方形ごとに塗りつぶす
+	for(k=FontSpanIndex[n];k<FontSpanIndex[n+1];k+=2){
+		y1=y+(FontSpan[k]>>4)*LCD_SCALE;
+		y2=y1+((FontSpan[k]&15)+1)*LCD_SCALE;
+		x1=x+(FontSpan[k+1]>>4)*LCD_SCALE;
+		x2=x1+((FontSpan[k+1]&15)+1)*LCD_SCALE;
+		if(x1<clip.x1) x1=clip.x1;
+		if(x2>clip.x2) x2=clip.x2;
+		if(y1<clip.y1) y1=clip.y1;
+		if(y2>clip.y2) y2=clip.y2;
+		if(x1<x2 && y1<y2) LCD_Fill(x1,y1,x2-x1,y2-y1,c1);
+	}
+	LCD_TxEnd();
 }
 
 void printstr(int x,int y,unsigned char c,int bc,unsigned char *s){
 	//座標(x,y)からカラーパレット番号cで文字列sを表示、bc:バックグランドカラー
 	//bcが負の場合は無視
-	while(*s){
-		putfont(x,y,c,bc,*s++);
-		x+=8;
+	//文字列全体を1つのウィンドウで送信する
+	int n,k;
+	n=strlen((char *)s);
+	while(n>0){
+		k=n>255?255:n;
+		putfontmap(x,y,c,bc,k,1,s,k);
+		x+=k*FONTSIZE;
+		s+=k;
+		n-=k;
+	}
+}
+void putfontmap(int x,int y,unsigned char c,int bc,unsigned char w,unsigned char h,const unsigned char *s,int stride){
+	//横w*縦h文字分の文字コード配列sを座標(x,y)から1つのウィンドウで連続表示
+	//カラー番号c、bc:バックグランドカラー、stride:配列sの1行分の要素数
+	//クリッピング範囲からはみ出す場合や背景色なしの場合は1文字ずつ表示
+	int i,j,k;
+	unsigned short c1;
+	if(bc<0 || x<clip.x1 || y<clip.y1 || x+w*FONTSIZE>clip.x2 || y+h*FONTSIZE>clip.y2){
+		for(i=0;i<h;i++){
+			for(j=0;j<w;j++) putfont(x+j*FONTSIZE,y+i*FONTSIZE,c,bc,s[i*stride+j]);
+		}
+		return;
 	}
+	c1=palette[c];
+	bc=palette[bc];
+	LCD_TxBegin();
+	LCD_TxWindow(x,y,w*FONTSIZE,h*FONTSIZE);
+	for(i=0;i<h;i++){
+		//各文字の展開済みの文字画像から1ラインずつ送信
+		for(k=0;k<FONTSIZE;k++){
+			for(j=0;j<w;j++) LCD_TxQueue(getglyph(s[j],c1,bc)+k*GLYPH_LINEBYTES,GLYPH_LINEBYTES);
+		}
+		s+=stride;
+	}
+	LCD_TxEnd();
 }
 void printnum(int x,int y,unsigned char c,int bc,unsigned int n){
 	//座標(x,y)にカラー番号cで数値nを表示、bc:バックグランドカラー
-	unsigned int d,e;
-	d=10;
-	e=0;
-	while(n>=d){
-		e++;
-		if(e==9) break;
-		d*=10;
-	}	
-	x+=e*8;
+	//数字の並びを1つのウィンドウで送信する
+	unsigned char buf[10];
+	int i;
+	i=10;
 	do{
-		putfont(x,y,c,bc,'0'+n%10);
+		buf[--i]='0'+n%10;
 		n/=10;
-		x-=8;
 	}while(n!=0);
+	putfontmap(x,y,c,bc,10-i,1,buf+i,10-i);
 }
 void printnum2(int x,int y,unsigned char c,int bc,unsigned int n,unsigned char e){
 	//座標(x,y)にカラー番号cで数値nを表示、bc:バックグランドカラー、e桁で表示
+	//数字の並びを1つのウィンドウで送信する
+	unsigned char buf[255];
+	int i;
 	if(e==0) return;
-	x+=(e-1)*8;
+	i=e;
 	do{
-		putfont(x,y,c,bc,'0'+n%10);
-		e--;
+		buf[--i]='0'+n%10;
 		n/=10;
-		x-=8;
-	}while(e!=0 && n!=0);
-	while(e!=0){
-		putfont(x,y,c,bc,' ');
-		x-=8;
-		e--;
+	}while(i!=0 && n!=0);
+	while(i!=0) buf[--i]=' ';
+	putfontmap(x,y,c,bc,e,1,buf,e);
+}
+
+// タイルマップ
+// 画面を文字単位のセルに分け、セルごとに表示する文字と色を保持する
+// 書き込まれた内容が表示済みの内容と異なるセルのみ、flushtiles()でまとめて液晶に送る
+#define TILE_W (X_RES/FONTSIZE)
+#define TILE_H (Y_RES/FONTSIZE)
+#ifndef TILE_BANDLINES
+#define TILE_BANDLINES 16 //redrawtiles()で1回に描画して送信するライン数
+#endif
+typedef struct {
+	unsigned char n; //文字番号
+	unsigned char c; //カラー番号
+	unsigned char bc; //バックグランドカラー番号
+} _Tile;
+// 表示内容不明のセルのtileshownに置く値
+// puttile()は文字色と背景色が同じ場合に文字番号と文字色を0に揃えるため、c==bc!=0のセルは書き込まれない
+#define TILE_STALE ((_Tile){0xff,0xff,0xff})
+static _Tile tilemap[TILE_H][TILE_W]; //書き込まれた内容
+static _Tile tileshown[TILE_H][TILE_W]; //液晶に表示済みの内容
+static unsigned char tilerowdirty[TILE_H]; //行内に未送信のセルがある
+static int tiledirty; //未送信のセル数
+static unsigned int tilerowpal[TILE_H][8]; //行内のセルが使っているカラー番号の集合（使わなくなった番号を含む場合あり）
+static int tilex0,tiley0; //タイルマップの左上の座標
+static unsigned char tilew,tileh; //画面に収まるセル数
+
+static int tilesame(int x,int y)
+//セル(x,y)が表示済みの内容と同じか
+{
+	return tilemap[y][x].n==tileshown[y][x].n && tilemap[y][x].c==tileshown[y][x].c
+		&& tilemap[y][x].bc==tileshown[y][x].bc;
+}
+
+static void resettiles(unsigned char bc)
+//タイルマップ全体を背景色bcの空白とし、全セルを表示内容不明にする
+{
+	int x,y;
+	for(y=0;y<TILE_H;y++){
+		for(x=0;x<TILE_W;x++){
+			tilemap[y][x]=(_Tile){0,0,bc};
+			tileshown[y][x]=TILE_STALE;
+		}
+		tilerowdirty[y]=1;
+		for(x=0;x<8;x++) tilerowpal[y][x]=0;
+		tilerowpal[y][bc>>5]=1u<<(bc&31);
 	}
+	tiledirty=tilew*tileh;
 }
 
-void init_graphic(void){
-	//グラフィックLCD使用開始
+void inittiles(int x0,int y0){
+	//タイルマップの左上を座標(x0,y0)とし、全セルを表示内容不明として初期化
+	tilex0=x0;
+	tiley0=y0;
+	tilew=(X_RES-x0)/FONTSIZE;
+	tileh=(Y_RES-y0)/FONTSIZE;
+	resettiles(0);
+}
+
+void cleartiles(unsigned char bc){
+	//画面全体をカラー番号bcで消去し、タイルマップも消去した状態にする
+	//タイルマップの範囲は次のflushtiles()で帯ごとに描画するため、ここでは範囲外のみ塗りつぶす
+	int x2,y2;
+	x2=tilex0+tilew*FONTSIZE;
+	y2=tiley0+tileh*FONTSIZE;
+	LCD_Fill(0,0,X_RES,tiley0,palette[bc]);
+	LCD_Fill(0,tiley0,tilex0,y2-tiley0,palette[bc]);
+	LCD_Fill(x2,tiley0,X_RES-x2,y2-tiley0,palette[bc]);
+	LCD_Fill(0,y2,X_RES,Y_RES-y2,palette[bc]);
+	resettiles(bc);
+}
+
+void puttile(int x,int y,unsigned char c,unsigned char bc,unsigned char n){
+	//タイルマップのセル(x,y)にカラー番号c、バックグランドカラーbcで文字番号nを書き込む
+	//液晶への送信はflushtiles()で行う
+	const unsigned char *p;
+	if(x<0 || x>=tilew || y<0 || y>=tileh) return;
+	//空白文字や文字色と背景色が同じ場合は、見た目が同じになる内容に揃える
+	p=FontData+n*8;
+	if(c==bc || (p[0]|p[1]|p[2]|p[3]|p[4]|p[5]|p[6]|p[7])==0){
+		n=0;
+		c=0;
+	}
+	if(!tilesame(x,y)) tiledirty--;
+	tilemap[y][x]=(_Tile){n,c,bc};
+	if(!tilesame(x,y)){
+		tilerowdirty[y]=1;
+		tiledirty++;
+	}
+	tilerowpal[y][c>>5]|=1u<<(c&31);
+	tilerowpal[y][bc>>5]|=1u<<(bc&31);
+}
+
+void puttilemap(int x,int y,int w,int h,unsigned char bc,const unsigned char *map){
+	//タイルマップのセル(x,y)から横w*縦hセルに、バックグランドカラーbcで配列mapの内容を書き込む
+	//mapは1セルを2バイト（文字番号、カラー番号）で表し、左上から横方向に並べたもの
+	//液晶への送信はflushtiles()で行う
+	int i,j;
+	for(i=0;i<h;i++){
+		for(j=0;j<w;j++){
+			puttile(x+j,y+i,map[1],bc,map[0]);
+			map+=2;
+		}
+	}
+}
+
+static void puttilerect(int x,int y,int w,int h)
+//タイルマップのセル(x,y)から横w*縦hセルを1つのウィンドウで送信
+{
+	int i,j,k;
+	_Tile *t;
+	LCD_TxBegin();
+	LCD_TxWindow(tilex0+x*FONTSIZE,tiley0+y*FONTSIZE,w*FONTSIZE,h*FONTSIZE);
+	for(i=y;i<y+h;i++){
+		for(k=0;k<FONTSIZE;k++){
+			t=&tilemap[i][x];
+			for(j=0;j<w;j++){
+				LCD_TxQueue(getglyph(t->n,palette[t->c],palette[t->bc])+k*GLYPH_LINEBYTES,GLYPH_LINEBYTES);
+				t++;
+			}
+		}
+		for(j=x;j<x+w;j++) tileshown[i][j]=tilemap[i][j];
+	}
+	LCD_TxEnd();
+	tiledirty-=w*h;
+	LCD_STAT(cells,w*h);
+	LCD_STAT(rects,1);
+}
+
+void redrawtiles(void){
+	//タイルマップ全体を1つのウィンドウで送信
+	//横TILE_BANDLINESライン分の帯ごとにバッファに描画してDMAで送信し、
+	//2つのバッファを交互に使って、一方の送信中にもう一方に次の帯を描画する
+	int i,j,k,ly,w,h;
+	unsigned char *bp;
+	_Tile *t;
+	static unsigned char bandbuf[2][LCD_PIXBYTES(X_RES*TILE_BANDLINES)];
+	w=tilew*FONTSIZE;
+	h=tileh*FONTSIZE;
+	k=0;
+	LCD_TxBegin();
+	LCD_TxWindow(tilex0,tiley0,w,h);
+	for(ly=0;ly<h;){
+		bp=bandbuf[k];
+		for(i=0;i<TILE_BANDLINES && ly<h;i++,ly++){
+			//各セルの展開済みの文字画像から1ラインずつ並べる
+			t=tilemap[ly/FONTSIZE];
+			for(j=0;j<tilew;j++){
+				memcpy(bp,getglyph(t->n,palette[t->c],palette[t->bc])+ly%FONTSIZE*GLYPH_LINEBYTES,GLYPH_LINEBYTES);
+				bp+=GLYPH_LINEBYTES;
+				t++;
+			}
+		}
+		LCD_TxDMA(bandbuf[k],bp-bandbuf[k]);
+		k^=1;
+	}
+	LCD_TxEnd();
+	for(i=0;i<tileh;i++){
+		for(j=0;j<tilew;j++) tileshown[i][j]=tilemap[i][j];
+		tilerowdirty[i]=0;
+	}
+	LCD_STAT(cells,tiledirty);
+	LCD_STAT(rects,1);
+	tiledirty=0;
+}
+
+void flushtilerows(int y1,int y2){
+	//タイルマップのy1行目からy2行目までの未送信のセルを液晶に送信
+	//未送信のセルを横方向、続いて縦方向に広げた長方形ごとに1つのウィンドウで送る
+	int x,y,w,h,i;
+	if(y1<0) y1=0;
+	if(y2>=tileh) y2=tileh-1;
+	for(y=y1;y<=y2;y++){
+		if(!tilerowdirty[y]) continue;
+		x=0;
+		while(x<tilew){
+			if(tilesame(x,y)){
+				x++;
+				continue;
+			}
+			for(w=1;x+w<tilew && !tilesame(x+w,y);w++) ;
+			for(h=1;y+h<=y2 && tilerowdirty[y+h];h++){
+				for(i=0;i<w;i++){
+					if(tilesame(x+i,y+h)) break;
+				}
+				if(i<w) break;
+			}
+			puttilerect(x,y,w,h);
+			x+=w;
+		}
+		tilerowdirty[y]=0;
+	}
+}
+
+void flushtiles(void){
+	//タイルマップの未送信のセルを全て液晶に送信
+	//未送信のセルが半分以上ある場合は、全体を帯ごとに描画して送信する
+	if(tiledirty*2>=tilew*tileh) redrawtiles();
+	else flushtilerows(0,tileh-1);
+}
+
+// パレットアニメーション
+// 色を変更したカラー番号を使っているセルを、行ごとのカラー番号の集合から探して未送信に戻す
+// 1フレームに未送信に戻すセル数を制限し、残りは次のフレームに回す
+#ifndef PALRAMP_MAX
+#define PALRAMP_MAX 8 //同時に変化させられるカラー番号の数
+#endif
+typedef struct {
+	unsigned char n; //カラー番号
+	unsigned char frames; //残りフレーム数、0の場合は未使用
+	unsigned char b,r,g; //変化後の色
+	short db,dr,dg; //1フレームあたりの変化量の256倍
+} _Palramp;
+static _Palramp palramp[PALRAMP_MAX];
+static unsigned int palstale[8]; //検索中のカラー番号の集合
+static unsigned int palnext[8]; //次に検索するカラー番号の集合
+static unsigned char palx,paly=TILE_H; //検索位置、paly>=tilehの場合は検索終了
+
+void changepalette(unsigned char n,unsigned char b,unsigned char r,unsigned char g){
+	//カラー番号nの色を変更し、タイルマップのnを使っているセルを再描画の対象にする
+	//再描画の対象にするのはanimpalette()、液晶への送信はflushtiles()で行う
+	set_palette(n,b,r,g);
+	palnext[n>>5]|=1u<<(n&31);
+}
+
+void fadepalette(unsigned char n,unsigned char b,unsigned char r,unsigned char g,unsigned char frames){
+	//カラー番号nの色を、animpalette()を呼ぶごとにframes回かけて現在の色から(b,r,g)に変化させる
+	_Palramp *p,*q;
+	if(frames==0){
+		changepalette(n,b,r,g);
+		return;
+	}
+	q=NULL;
+	for(p=palramp;p<palramp+PALRAMP_MAX;p++){
+		if(p->frames && p->n==n) break; //変化中の場合は置き換える
+		if(p->frames==0 && q==NULL) q=p;
+	}
+	if(p==palramp+PALRAMP_MAX) p=q;
+	if(p==NULL){
+		changepalette(n,b,r,g); //空きがない場合はすぐに変更
+		return;
+	}
+	p->n=n;
+	p->frames=frames;
+	p->b=b;
+	p->r=r;
+	p->g=g;
+	p->db=((int)b-palettergb[n][0])*256/frames;
+	p->dr=((int)r-palettergb[n][1])*256/frames;
+	p->dg=((int)g-palettergb[n][2])*256/frames;
+}
+
+void cyclepalette(unsigned char n1,unsigned char n2){
+	//カラー番号n1からn2までの色を1つずつずらし、n2の色をn1に移す
+	unsigned char c[3];
 	int i;
+	if(n1>=n2) return;
+	memcpy(c,palettergb[n2],3);
+	for(i=n2;i>n1;i--) changepalette(i,palettergb[i-1][0],palettergb[i-1][1],palettergb[i-1][2]);
+	changepalette(n1,c[0],c[1],c[2]);
+}
+
+static int palbit(const unsigned int *m,unsigned char n)
+//カラー番号の集合mにnが含まれるか
+{
+	return (m[n>>5]>>(n&31))&1;
+}
+
+int animpalette(int budget){
+	//パレットアニメーションを1フレーム進め、色が変わったセルを最大budgetセルまで未送信に戻す
+	//液晶への送信はflushtiles()で行う。まだ変化中または未送信に戻していないセルがある場合は1を返す
+	//カラー番号からセルへの逆引きは、セルの一覧ではなく行ごとのカラー番号の集合（tilerowpal、
+	//256ビット）で行う。変更した番号を含む行だけを走査し、その行内で該当するセルを探す
+	int k,busy;
+	unsigned int m;
+	_Palramp *p;
+	_Tile *t;
+	busy=0;
+	for(p=palramp;p<palramp+PALRAMP_MAX;p++){
+		if(p->frames==0) continue;
+		p->frames--;
+		changepalette(p->n,(p->b*256-p->frames*p->db+128)>>8,(p->r*256-p->frames*p->dr+128)>>8,
+			(p->g*256-p->frames*p->dg+128)>>8);
+		if(p->frames) busy=1;
+	}
+	if(paly>=tileh){
+		//前回の検索が終わっていれば、その後に変更されたカラー番号の検索を始める
+		m=0;
+		for(k=0;k<8;k++){
+			palstale[k]=palnext[k];
+			palnext[k]=0;
+			m|=palstale[k];
+		}
+		if(m==0) return busy;
+		palx=0;
+		paly=0;
+	}
+	while(paly<tileh){
+		for(k=0;k<8 && (tilerowpal[paly][k]&palstale[k])==0;k++) ;
+		if(k<8){
+			t=&tilemap[paly][palx];
+			for(;palx<tilew;palx++,t++){
+				if(!palbit(palstale,t->c) && !palbit(palstale,t->bc)) continue;
+				if(!tilesame(palx,paly)) continue; //未送信のセルは送信時に新しい色になる
+				if(budget<=0) return 1;
+				tileshown[paly][palx]=TILE_STALE;
+				tilerowdirty[paly]=1;
+				tiledirty++;
+				budget--;
+			}
+		}
+		palx=0;
+		paly++;
+	}
+	for(k=0;k<8;k++){
+		if(palnext[k]) busy=1;
+	}
+	return busy;
+}
+
+void init_graphic_begin(void){
+	//グラフィックLCD使用開始の前半、液晶のリセット待ちの間にパレットを初期化
+	int i;
+	LCD_InitBegin();
 	//カラーパレット初期化
 	for(i=0;i<8;i++){
 		set_palette(i,255*(i&1),255*((i>>1)&1),255*(i>>2));
@@ -607,7 +1466,18 @@ void init_graphic(void){
 	for(i=16;i<256;i++){
 		set_palette(i,255,255,255);
 	}
+	inittiles(0,0);
+}
+
+void init_graphic_end(void){
+	//グラフィックLCD使用開始の後半、表示はオフのまま
+	LCD_InitEnd();
+}
 
-	LCD_Init();
+void init_graphic(void){
+	//グラフィックLCD使用開始
+	init_graphic_begin();
+	init_graphic_end();
 	LCD_Clear(0);
-}
\ No newline at end of file
+	LCD_DisplayOn();
+}
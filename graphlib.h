@@ -9,6 +9,10 @@ void putbmpmn(int x,int y,unsigned char m,unsigned char n,const unsigned char bm
 // unsigned char bmp[m*n]配列に、単純にカラー番号を髞ﾗる
 // カラー番号が0の部分は透明色として扱う
 
+void putrle(int x,int y,const unsigned char *rle);
+// RLE形式のスプライト（tools/mkrle.cで作成）を座標x,yに表示
+// カラー番号0の部分は透明色として扱う
+
 void clrbmpmn(int x,int y,unsigned char m,unsigned char n);
 // 縦m*横nドットのキャラクター習雕
 // カラー0で塗りつぶし
@@ -28,8 +32,15 @@ void boxfill(int x1,int y1,int x2,int y2,unsigned char c);
 void circlefill(int x0,int y0,unsigned int r,unsigned char c);
 // (x0,y0)を中心に、半径r、カラーcで塗られた円を描画
 
+void polygonfill(int n,const int *xy,unsigned char c);
+// n個の頂点(xy[0],xy[1])、(xy[2],xy[3])…を順に結んだ凸多角形をカラーcで塗りつぶし
+
+void trianglefill(int x1,int y1,int x2,int y2,int x3,int y3,unsigned char c);
+// (x1,y1)、(x2,y2)、(x3,y3)を頂点とする三角形をカラーcで塗りつぶし
+
 void putfont(int x,int y,unsigned char c,int bc,unsigned char n);
 //8*8ドットのアルファベットフォント表示
+//LCD_SCALE倍に拡大し、FONTSIZE*FONTSIZEドットで表示
 //座標（x,y)、カラー番号c
 //bc:バックグランドカラー、負数の場合無視
 //n:文字番号
@@ -37,6 +48,10 @@ void putfont(int x,int y,unsigned char c,int bc,unsigned char n);
 void printstr(int x,int y,unsigned char c,int bc,unsigned char *s);
 //座標(x,y)からカラー番号cで文字列sを表示、bc:バックグランドカラー
 
+void putfontmap(int x,int y,unsigned char c,int bc,unsigned char w,unsigned char h,const unsigned char *s,int stride);
+//横w*縦h文字分の文字コード配列sを座標(x,y)から1つのウィンドウで連続表示
+//カラー番号c、bc:バックグランドカラー、stride:配列sの1行分の要素数
+
 void printnum(int x,int y,unsigned char c,int bc,unsigned int n);
 //座標(x,y)にカラー番号cで数値nを表示、bc:バックグランドカラー
 
@@ -46,5 +61,59 @@ void printnum2(int x,int y,unsigned char c,int bc,unsigned int n,unsigned char e
 void init_graphic(void);
 //グラフィックLCD使用開始
 
+void init_graphic_begin(void);
+//グラフィックLCD使用開始の前半、液晶のリセット待ちの間にパレットを初期化
+//この後、他の初期化処理を行ってからinit_graphic_end()を呼び出す
+
+void init_graphic_end(void);
+//グラフィックLCD使用開始の後半、表示はオフのまま
+//画面を描画してからLCD_DisplayOn()で表示を開始する
+
 extern unsigned short palette[];
 //パレット用配列
+
+void inittiles(int x0,int y0);
+//タイルマップの左上を座標(x0,y0)とし、全セルを表示内容不明として初期化
+
+void cleartiles(unsigned char bc);
+//画面全体をカラー番号bcで消去し、タイルマップも消去した状態にする
+
+void puttile(int x,int y,unsigned char c,unsigned char bc,unsigned char n);
+//タイルマップのセル(x,y)にカラー番号c、バックグランドカラーbcで文字番号nを書き込む
+//液晶への送信はflushtiles()で行う
+
+void flushtilerows(int y1,int y2);
+//タイルマップのy1行目からy2行目までの未送信のセルを液晶に送信
+
+void flushtiles(void);
+//タイルマップの未送信のセルを全て液晶に送信
+
+void redrawtiles(void);
+//タイルマップ全体を、横方向の帯ごとにバッファに描画しながらDMAで送信
+
+void changepalette(unsigned char n,unsigned char b,unsigned char r,unsigned char g);
+//カラー番号nの色を変更し、タイルマップのnを使っているセルを次のanimpalette()で再描画の対象にする
+
+void fadepalette(unsigned char n,unsigned char b,unsigned char r,unsigned char g,unsigned char frames);
+//カラー番号nの色を、animpalette()を呼ぶごとにframes回かけて現在の色から(b,r,g)に変化させる
+
+void cyclepalette(unsigned char n1,unsigned char n2);
+//カラー番号n1からn2までの色を1つずつずらし、n2の色をn1に移す
+
+int animpalette(int budget);
+//パレットアニメーションを1フレーム進め、色が変わったセルを最大budgetセルまで未送信に戻す
+//液晶への送信はflushtiles()で行う。まだ変化中または未送信に戻していないセルがある場合は1を返す
+
+void puttilemap(int x,int y,int w,int h,unsigned char bc,const unsigned char *map);
+//タイルマップのセル(x,y)から横w*縦hセルに、バックグランドカラーbcで配列mapの内容を書き込む
+//mapは1セルを2バイト（文字番号、カラー番号）で表し、左上から横方向に並べたもの
+
+void pushclip(int x,int y,int w,int h);
+//現在のクリッピング範囲を保存し、(x,y)から横w*縦hの範囲との重なりを新しい範囲にする
+//pset、putbmpmn、putrle、putfont、gline、boxfillなどの描画はクリッピング範囲の内側のみに行う
+
+void popclip(void);
+//pushclip()で保存したクリッピング範囲に戻す
+
+void putqoi(int x,int y,const unsigned char *qoi);
+//QOI形式のフルカラー画像（tools/mkqoi.cで作成）を座標(x,y)に表示。1ラインずつデコードして送信する
@@ -1,8 +1,32 @@
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/spi.h"
+#include "hardware/dma.h"
 #include "LCDdriver.h"
 
+static int lcd_dma_ch=-1; //液晶転送用DMAチャンネル
+#if LCD_COLORMODE == LCD_COLOR18
+#define LCD_FILLPIX 128 //塗りつぶし用パターンの画素数
+static unsigned char lcd_fillbuf[LCD_PIXBYTES(LCD_FILLPIX)]; //塗りつぶし色を並べたパターン
+#else
+static unsigned short lcd_fillword; //塗りつぶし色（送信順にバイト入れ替え済み）
+#endif
+static volatile unsigned char lcd_dma_active; //DMA転送中
+static unsigned char lcd_spi12; //SPIを12ビットフレームに切り替えて転送中
+static unsigned char lcd_txdepth; //トランザクションの入れ子の深さ
+static unsigned char lcd_cs_release; //DMA転送完了時にCSを解放する
+static unsigned char lcd_dcstate=1; //現在のDC出力（0:コマンド、1:データ）
+static unsigned short lcd_win[4]; //設定済みのアドレスウィンドウ（x1,x2,y1,y2）
+static unsigned char lcd_winvalid; //lcd_winが液晶側の設定と一致している
+static unsigned char lcd_ramwr; //メモリ書き込み中（書き込み位置を追跡中）
+static unsigned short lcd_wptrx,lcd_wptry; //メモリ書き込みの開始位置
+static unsigned int lcd_wbytes; //書き込み開始位置から書き込んだバイト数
+static unsigned char lcd_qbuf[2][LCD_QBUFSIZE]; //転送キュー（交互に使用するバッファ）
+static unsigned char lcd_qidx; //データを詰めている側のバッファ
+static int lcd_qlen; //lcd_qbuf[lcd_qidx]に詰めたバイト数
+_LCDstats lcdstats; //液晶転送の統計情報
+
 static inline void lcd_cs_lo() {
     asm volatile("nop \n nop \n nop");
     gpio_put(LCD_CS, 0);
@@ -37,47 +61,417 @@ static inline void lcd_reset_hi() {
     asm volatile("nop \n nop \n nop");
 }
 
-void LCD_WriteComm(unsigned char comm){
-// Write Command
-	lcd_dc_lo();
+static void lcd_dc_set(unsigned char dc)
+{
+// DC出力を変更（同じ値の場合は何もしない）
+	if(lcd_dcstate==dc) return;
+	if(dc) lcd_dc_hi();
+	else lcd_dc_lo();
+	lcd_dcstate=dc;
+	LCD_STAT(dc,1);
+}
+
+static void lcd_dma_send(const void *b,int n,unsigned char ring,enum dma_channel_transfer_size size)
+{
+// バッファbからsize単位でn回分をDMAで送信開始（DC出力、前の転送の完了は呼び出し側で済ませる）
+// ring:読み出しアドレスを2^ringバイトごとに戻す（0の場合は戻さない）
+	dma_channel_config c;
+	c=dma_channel_get_default_config(lcd_dma_ch);
+	channel_config_set_transfer_data_size(&c, size);
+	channel_config_set_read_increment(&c, true);
+	channel_config_set_write_increment(&c, false);
+	if(ring) channel_config_set_ring(&c, false, ring);
+	channel_config_set_dreq(&c, spi_get_dreq(SPICH, true));
+	lcd_dma_active=1;
+	dma_channel_configure(lcd_dma_ch, &c, &spi_get_hw(SPICH)->dr, b, n, true);
+}
+
+static void lcd_dma_wait(void)
+{
+// DMA転送の完了とSPIの送信完了を待つ
+	if(!lcd_dma_active) return;
+	dma_channel_wait_for_finish_blocking(lcd_dma_ch);
+	while(spi_is_busy(SPICH)) tight_loop_contents();
+	// 転送中に受信FIFOに溜まったデータを捨ててオーバーランをクリア
+	while(spi_is_readable(SPICH)) (void)spi_get_hw(SPICH)->dr;
+	spi_get_hw(SPICH)->icr = SPI_SSPICR_RORIC_BITS;
+	if(lcd_spi12){
+		spi_set_format(SPICH, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+		lcd_spi12=0;
+	}
+	lcd_dma_active=0;
+}
+
+static void lcd_qkick(void)
+{
+// 転送キューに詰めたデータのDMA送信を開始し、もう一方のバッファに切り替える
+	if(lcd_qlen==0) return;
+	if(lcd_spi12) lcd_dma_wait(); //8ビットフレームに戻してから送る
+	else if(lcd_dma_active) dma_channel_wait_for_finish_blocking(lcd_dma_ch);
+	lcd_dma_send(lcd_qbuf[lcd_qidx],lcd_qlen,0,DMA_SIZE_8);
+	lcd_qidx^=1;
+	lcd_qlen=0;
+}
+
+void LCD_WaitDMA(void)
+{
+// 転送キューの残りを送信し、全てのDMA転送の完了を待つ
+// 転送中にLCD_TxEnd()されていればCSを解放する
+	lcd_qkick();
+	lcd_dma_wait();
+	if(lcd_cs_release){
+		lcd_cs_release=0;
+		lcd_cs_hi();
+	}
+}
+
+void LCD_TxBegin(void)
+{
+// トランザクション開始（CSアサート）
+// 入れ子にした場合は一番外側のLCD_TxEnd()までCSをアサートしたままにする
+	if(lcd_txdepth++) return;
+	if(lcd_cs_release){
+		//DMA転送中の前トランザクションのCSをそのまま引き継ぐ
+		lcd_cs_release=0;
+		return;
+	}
 	lcd_cs_lo();
+	LCD_STAT(cs,1);
+}
+
+void LCD_TxEnd(void)
+{
+// トランザクション終了（CS解放）
+// DMA転送中の場合はすぐに戻り、転送完了時にCSを解放する
+	if(--lcd_txdepth) return;
+	lcd_qkick();
+	if(lcd_dma_active) lcd_cs_release=1;
+	else lcd_cs_hi();
+}
+
+static void lcd_comm(unsigned char comm)
+{
+// コマンド送信（ウィンドウキャッシュは更新しない）
+	LCD_WaitDMA();
+	lcd_dc_set(0);
 	spi_write_blocking(SPICH, &comm , 1);
-	lcd_cs_hi();
+	lcd_ramwr=0;
+	LCD_STAT(bytes,1);
+}
+
+void LCD_TxComm(unsigned char comm)
+{
+// トランザクション中にコマンドを送信
+	lcd_comm(comm);
+	//アドレスウィンドウを変更するコマンドの場合はキャッシュを無効化
+	if(comm==0x01 || comm==0x2a || comm==0x2b || comm==0x36) lcd_winvalid=0;
+}
+
+void LCD_TxData(const unsigned char *b,int n)
+{
+// トランザクション中にデータをnバイト送信
+	LCD_WaitDMA();
+	lcd_dc_set(1);
+	spi_write_blocking(SPICH, b, n);
+	if(lcd_ramwr) lcd_wbytes+=n;
+	LCD_STAT(bytes,n);
+}
+
+void LCD_TxQueue(const unsigned char *b,int n)
+{
+// トランザクション中にデータをnバイト送信キューに積む
+// 2つのバッファに交互に詰め、一杯になった側からDMAで送信する
+// bの内容はコピーするので、戻った後すぐに書き換えてよい
+	int k;
+	if(lcd_dcstate!=1){
+		LCD_WaitDMA();
+		lcd_dc_set(1);
+	}
+	if(lcd_ramwr) lcd_wbytes+=n;
+	LCD_STAT(bytes,n);
+	while(n>0){
+		k=LCD_QBUFSIZE-lcd_qlen;
+		if(k>n) k=n;
+		memcpy(lcd_qbuf[lcd_qidx]+lcd_qlen,b,k);
+		lcd_qlen+=k;
+		b+=k;
+		n-=k;
+		if(lcd_qlen==LCD_QBUFSIZE) lcd_qkick();
+	}
+}
+
+void LCD_TxDMA(const unsigned char *b,int n)
+{
+// トランザクション中にバッファbのnバイトをDMAで送信開始してすぐに戻る
+// 前のDMA転送の完了は待つので、2つのバッファを交互に使えば送信中に次のデータを用意できる
+// bの内容は次のLCD_TxDMA()の後か、LCD_WaitDMA()まで書き換えないこと
+	if(lcd_dcstate!=1){
+		LCD_WaitDMA();
+		lcd_dc_set(1);
+	}
+	lcd_qkick();
+	if(lcd_spi12) lcd_dma_wait();
+	else if(lcd_dma_active) dma_channel_wait_for_finish_blocking(lcd_dma_ch);
+	lcd_dma_send(b,n,0,DMA_SIZE_8);
+	if(lcd_ramwr) lcd_wbytes+=n;
+	LCD_STAT(bytes,n);
+}
+
+int LCD_PackPixels(unsigned char *b,const unsigned short *c,int n)
+{
+// 画素色の配列cのn画素分を液晶への送信形式に変換してbに書き込み、バイト数を返す
+	unsigned char *p=b;
+#if LCD_COLORMODE == LCD_COLOR12
+	// 2画素を3バイトに詰める。画素数が奇数の場合、最後の画素は4ビット余らせて2バイトで送る
+	for(;n>=2;n-=2){
+		*p++=c[0]>>4;
+		*p++=(c[0]<<4)|(c[1]>>8);
+		*p++=(unsigned char)c[1];
+		c+=2;
+	}
+	if(n){
+		*p++=c[0]>>4;
+		*p++=c[0]<<4;
+	}
+#elif LCD_COLORMODE == LCD_COLOR18
+	// RGB565の各色を上位に詰めて1バイトずつ送る
+	for(;n>0;n--){
+		*p++=(*c>>8)&0xf8;
+		*p++=(*c>>3)&0xfc;
+		*p++=*c++<<3;
+	}
+#else
+	for(;n>0;n--){
+		*p++=*c>>8;
+		*p++=(unsigned char)*c++;
+	}
+#endif
+	return p-b;
+}
+
+void LCD_TxData2(unsigned short data)
+{
+// トランザクション中に2バイトデータを上位から送信
+	unsigned char d[2];
+	d[0]=data>>8;
+	d[1]=(unsigned char)data;
+	LCD_TxData(d,2);
+}
+
+static void lcd_dma_fill(unsigned short color,int n)
+{
+// トランザクション中、アドレスウィンドウ設定済みの液晶にcolorをn画素分DMAで連続送信
+// 転送完了を待たずに戻る
+#if LCD_COLORMODE == LCD_COLOR18
+	int k;
+#endif
+	LCD_WaitDMA();
+	lcd_dc_set(1);
+#if LCD_COLORMODE == LCD_COLOR12
+	// SPIを12ビットフレームに切り替え、1画素1フレームで同じ値を繰り返し送る
+	spi_set_format(SPICH, 12, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+	lcd_spi12=1;
+	lcd_fillword=color;
+	lcd_dma_send(&lcd_fillword,n,1,DMA_SIZE_16);
+#elif LCD_COLORMODE == LCD_COLOR18
+	// 3バイト単位はリングバッファにできないため、パターンを繰り返し送る
+	// 最後の1回分のみ完了を待たずに戻る
+	k=LCD_PackPixels(lcd_fillbuf,&color,1);
+	while(k<LCD_PIXBYTES(LCD_FILLPIX)){
+		lcd_fillbuf[k]=lcd_fillbuf[k-3];
+		k++;
+	}
+	for(k=n;k>LCD_FILLPIX;k-=LCD_FILLPIX){
+		lcd_dma_send(lcd_fillbuf,LCD_PIXBYTES(LCD_FILLPIX),0,DMA_SIZE_8);
+		dma_channel_wait_for_finish_blocking(lcd_dma_ch);
+	}
+	lcd_dma_send(lcd_fillbuf,LCD_PIXBYTES(k),0,DMA_SIZE_8);
+#else
+	// 2バイトのリングバッファとして読み出し、同じ値を繰り返し送る
+	lcd_fillword=(color>>8) | (color<<8);
+	lcd_dma_send(&lcd_fillword,n*2,1,DMA_SIZE_8);
+#endif
+	if(lcd_ramwr) lcd_wbytes+=LCD_PIXBYTES(n);
+	LCD_STAT(bytes,LCD_PIXBYTES(n));
+}
+
+void LCD_WriteComm(unsigned char comm){
+// Write Command
+	LCD_TxBegin();
+	LCD_TxComm(comm);
+	LCD_TxEnd();
 }
 
 void LCD_WriteData(unsigned char data)
 {
 // Write Data
-	lcd_dc_hi();
-	lcd_cs_lo();
-	spi_write_blocking(SPICH, &data , 1);
-	lcd_cs_hi();
+	LCD_TxBegin();
+	LCD_TxData(&data,1);
+	LCD_TxEnd();
 }
 
 void LCD_WriteData2(unsigned short data)
 {
 // Write Data 2 bytes
-    unsigned short d;
-	lcd_dc_hi();
-	lcd_cs_lo();
-    d=(data>>8) | (data<<8);
-	spi_write_blocking(SPICH, (unsigned char *)&d, 2);
-	lcd_cs_hi();
+	LCD_TxBegin();
+	LCD_TxData2(data);
+	LCD_TxEnd();
 }
 
 void LCD_WriteDataN(unsigned char *b,int n)
 {
 // Write Data N bytes
-	lcd_dc_hi();
-	lcd_cs_lo();
-	spi_write_blocking(SPICH, b,n);
-	lcd_cs_hi();
+	LCD_TxBegin();
+	LCD_TxData(b,n);
+	LCD_TxEnd();
 }
 
-void LCD_Init()
+#if LCD_STATS
+void LCD_PrintStats(const char *s)
 {
+// 統計情報を表示してクリア
+	printf("%s: cs=%u dc=%u bytes=%u winskip=%u wincont=%u cells=%u rects=%u ghit=%u gmiss=%u\n",s,
+		lcdstats.cs,lcdstats.dc,lcdstats.bytes,lcdstats.winskip,lcdstats.wincont,
+		lcdstats.cells,lcdstats.rects,lcdstats.ghit,lcdstats.gmiss);
+	lcdstats=(_LCDstats){0};
+}
+#endif
+
+// 初期化コマンド表
+// コマンド, パラメータ数, パラメータ... の繰り返し、コマンド0x00で終了
+// パラメータ数にLCD_INIT_DELAYを加えた場合は、パラメータの後に送信後の待ち時間(ms)を置く
+#define LCD_INIT_DELAY 0x80
+
+#if LCD_COLORMODE == LCD_COLOR12
+#define LCD_COLMOD 0x53
+#elif LCD_COLORMODE == LCD_COLOR18
+#define LCD_COLMOD 0x66
+#else
+#define LCD_COLMOD 0x55
+#endif
+
+// Memory Access Control（横向きは行列交換(MV)で、書き込みは常にx方向に進む）
+#if LCD_CONTROLLER == LCD_ST7789
+	#if LCD_ALIGNMENT == VERTICAL
+	#define LCD_MADCTL 0x00
+	#else
+	#define LCD_MADCTL 0x60
+	#endif
+#elif LCD_CONTROLLER == LCD_ILI9488
+	#if LCD_ALIGNMENT == VERTICAL
+	#define LCD_MADCTL 0x48
+	#else
+	#define LCD_MADCTL 0x28
+	#endif
+#else
+	#if LCD_ALIGNMENT == VERTICAL
+	#define LCD_MADCTL 0x48
+	#else
+	#define LCD_MADCTL 0x2C
+	#endif
+#endif
+
+static const unsigned char lcd_initcmd[]={
+#if LCD_CONTROLLER == LCD_ILI9341
+	0xCB,5, 0x39,0x2C,0x00,0x34,0x02,
+	0xCF,3, 0x00,0xC1,0x30,
+	0xE8,3, 0x85,0x00,0x78,
+	0xEA,2, 0x00,0x00,
+	0xED,4, 0x64,0x03,0x12,0x81,
+	0xF7,1, 0x20,
+	0xC0,1, 0x23,
+	0xC1,1, 0x10,
+	0xC5,2, 0x3e,0x28,
+	0xC7,1, 0x86,
+	0x36,1, LCD_MADCTL,
+	0x37,2, 0x00,0x00,
+	0x3A,1, LCD_COLMOD,
+	0xB1,2, 0x00,0x18,
+	0xB6,4, 0x0A,0x82,0x27,0x00,
+	0x26,1, 0x01,
+	0xE0,15, 0x0F,0x3a,0x36,0x0b,0x0d,0x06,0x4c,0x91,0x31,0x08,0x10,0x04,0x11,0x0c,0x00,
+	0xE1,15, 0x00,0x06,0x0a,0x05,0x12,0x09,0x2c,0x92,0x3f,0x08,0x0e,0x0b,0x2e,0x33,0x0F,
+#elif LCD_CONTROLLER == LCD_ST7789
+	0x36,1, LCD_MADCTL,
+	0x37,2, 0x00,0x00,
+	0x3A,1, LCD_COLMOD,
+	0xB2,5, 0x0C,0x0C,0x00,0x33,0x33,
+	0xB7,1, 0x35,
+	0xBB,1, 0x19,
+	0xC0,1, 0x2C,
+	0xC2,1, 0x01,
+	0xC3,1, 0x12,
+	0xC4,1, 0x20,
+	0xC6,1, 0x0F,
+	0xD0,2, 0xA4,0xA1,
+	0xE0,14, 0xD0,0x04,0x0D,0x11,0x13,0x2B,0x3F,0x54,0x4C,0x18,0x0D,0x0B,0x1F,0x23,
+	0xE1,14, 0xD0,0x04,0x0C,0x11,0x13,0x2C,0x3F,0x44,0x51,0x2F,0x1F,0x1F,0x20,0x23,
+	0x21,0, //IPSパネルは表示反転で正しい色になる
+#elif LCD_CONTROLLER == LCD_ILI9488
+	0xE0,15, 0x00,0x03,0x09,0x08,0x16,0x0A,0x3F,0x78,0x4C,0x09,0x0A,0x08,0x16,0x1A,0x0F,
+	0xE1,15, 0x00,0x16,0x19,0x03,0x0F,0x05,0x32,0x45,0x46,0x04,0x0E,0x0D,0x35,0x37,0x0F,
+	0xC0,2, 0x17,0x15,
+	0xC1,1, 0x41,
+	0xC5,3, 0x00,0x12,0x80,
+	0x36,1, LCD_MADCTL,
+	0x37,2, 0x00,0x00,
+	0x3A,1, LCD_COLMOD,
+	0xB0,1, 0x00,
+	0xB1,1, 0xA0,
+	0xB4,1, 0x02,
+	0xB6,2, 0x02,0x02,
+	0xE9,1, 0x00,
+	0xF7,4, 0xA9,0x51,0x2C,0x82,
+#endif
+#if LCD_TE >= 0
+	0x35,1, 0x00, //Tearing Effect Line ON（垂直ブランキング期間のみ）
+#endif
+	0x11,0+LCD_INIT_DELAY, 5, //Sleep Out後、次のコマンドまで5ms
+	0x00
+};
+
+static absolute_time_t lcd_initdeadline; //次の初期化手順を実行できる時刻
+static unsigned char lcd_displayon; //表示オン済み
+static volatile uint32_t lcd_tetime; //最後に垂直ブランキングが始まった時刻(us)
+static unsigned short lcd_scroll; //縦スクロール位置（表示の先頭ラインのメモリ上の行）
+
+#if LCD_TE >= 0
+static void lcd_te_irq(uint gpio,uint32_t events)
+{
+// TE出力の立ち上がり（垂直ブランキング開始）の時刻を記録
+	lcd_tetime=time_us_32();
+}
+#endif
+
+static void lcd_sendcmds(const unsigned char *p)
+{
+// 初期化コマンド表の内容を1つのトランザクションで送信
+	unsigned char n;
+	LCD_TxBegin();
+	while(*p){
+		LCD_TxComm(*p++);
+		n=*p++;
+		LCD_TxData(p,n&~LCD_INIT_DELAY);
+		p+=n&~LCD_INIT_DELAY;
+		if(n&LCD_INIT_DELAY) sleep_ms(*p++);
+	}
+	LCD_TxEnd();
+}
+
+void LCD_InitBegin(void)
+{
+// 液晶のリセットを開始してすぐに戻る
+// リセット後の待ち時間の間に他の初期化を行い、その後LCD_InitEnd()を呼び出す
+	LCD_WaitDMA();
+	if(lcd_dma_ch<0) lcd_dma_ch=dma_claim_unused_channel(true);
+	lcd_txdepth=0;
 	lcd_cs_hi();
 	lcd_dc_hi();
+	lcd_dcstate=1;
+	lcd_winvalid=0;
+	lcd_ramwr=0;
+	lcd_displayon=0;
+	lcd_scroll=0;
 
 	// Reset controller
 	lcd_reset_hi();
@@ -85,120 +479,108 @@ void LCD_Init()
 	lcd_reset_lo();
 	sleep_ms(10);
 	lcd_reset_hi();
-	sleep_ms(120);
-
-//************* Start Initial Sequence **********//
-	LCD_WriteComm(0xCB);
-	LCD_WriteData(0x39);
-	LCD_WriteData(0x2C);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x34);
-	LCD_WriteData(0x02);
-	LCD_WriteComm(0xCF);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0XC1);
-	LCD_WriteData(0X30);
-	LCD_WriteComm(0xE8);
-	LCD_WriteData(0x85);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x78);
-	LCD_WriteComm(0xEA);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x00);
-	LCD_WriteComm(0xED);
-	LCD_WriteData(0x64);
-	LCD_WriteData(0x03);
-	LCD_WriteData(0X12);
-	LCD_WriteData(0X81);
-	LCD_WriteComm(0xF7);
-	LCD_WriteData(0x20);
-	LCD_WriteComm(0xC0);
-	LCD_WriteData(0x23);
-	LCD_WriteComm(0xC1);
-	LCD_WriteData(0x10);
-	LCD_WriteComm(0xC5);
-	LCD_WriteData(0x3e);
-	LCD_WriteData(0x28);
-	LCD_WriteComm(0xC7);
-	LCD_WriteData(0x86);
-	LCD_WriteComm(0x36);
-#if LCD_ALIGNMENT == VERTICAL
-	LCD_WriteData(0x48);
-#elif LCD_ALIGNMENT == HORIZONTAL
-	LCD_WriteData(0x0C);
-#endif
-	LCD_WriteComm(0x37);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x00);
-	LCD_WriteComm(0x3A);
-	LCD_WriteData(0x55);
-	LCD_WriteComm(0xB1);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x18);
-	LCD_WriteComm(0xB6);
-	LCD_WriteData(0x0A);
-	LCD_WriteData(0x82);
-	LCD_WriteData(0x27);
-	LCD_WriteData(0x00);
-//	LCD_WriteComm(0xF2);
-//	LCD_WriteData(0x00);
-	LCD_WriteComm(0x26);
-	LCD_WriteData(0x01);
-	LCD_WriteComm(0xE0);
-	LCD_WriteData(0x0F);
-	LCD_WriteData(0x3a);
-	LCD_WriteData(0x36);
-	LCD_WriteData(0x0b);
-	LCD_WriteData(0x0d);
-	LCD_WriteData(0x06);
-	LCD_WriteData(0x4c);
-	LCD_WriteData(0x91);
-	LCD_WriteData(0x31);
-	LCD_WriteData(0x08);
-	LCD_WriteData(0x10);
-	LCD_WriteData(0x04);
-	LCD_WriteData(0x11);
-	LCD_WriteData(0x0c);
-	LCD_WriteData(0x00);
-	LCD_WriteComm(0XE1);
-	LCD_WriteData(0x00);
-	LCD_WriteData(0x06);
-	LCD_WriteData(0x0a);
-	LCD_WriteData(0x05);
-	LCD_WriteData(0x12);
-	LCD_WriteData(0x09);
-	LCD_WriteData(0x2c);
-	LCD_WriteData(0x92);
-	LCD_WriteData(0x3f);
-	LCD_WriteData(0x08);
-	LCD_WriteData(0x0e);
-	LCD_WriteData(0x0b);
-	LCD_WriteData(0x2e);
-	LCD_WriteData(0x33);
-	LCD_WriteData(0x0F);
-	LCD_WriteComm(0x11);
-	sleep_ms(120);
+	lcd_initdeadline=make_timeout_time_ms(120);
+}
+
+void LCD_InitEnd(void)
+{
+// リセット後の待ち時間が過ぎるのを待って初期化コマンドを送信しSleep Outする
+// 表示はオフのまま。画面を描画してからLCD_DisplayOn()で表示を開始する
+	sleep_until(lcd_initdeadline);
+	lcd_sendcmds(lcd_initcmd);
+	lcd_initdeadline=make_timeout_time_ms(120-5);
+}
+
+void LCD_DisplayOn(void)
+{
+// 表示オン（Sleep Outから120ms経過するまで待つ）
+	if(lcd_displayon) return;
+	sleep_until(lcd_initdeadline);
 	LCD_WriteComm(0x29);
+	lcd_displayon=1;
+	// TE出力がない場合は、表示オンの時刻を走査開始とみなして以後の走査位置を推定する
+	lcd_tetime=time_us_32();
+#if LCD_TE >= 0
+	gpio_init(LCD_TE);
+	gpio_set_dir(LCD_TE, GPIO_IN);
+	gpio_set_irq_enabled_with_callback(LCD_TE, GPIO_IRQ_EDGE_RISE, true, &lcd_te_irq);
+#endif
 }
 
-void LCD_setAddrWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+void LCD_Init()
 {
-#if LCD_ALIGNMENT == VERTICAL
-	LCD_WriteComm(0x2a);
-	LCD_WriteData2(x);
-	LCD_WriteData2(x+w-1);
-	LCD_WriteComm(0x2b);
-	LCD_WriteData2(y);
-	LCD_WriteData2(y+h-1);
-#elif LCD_ALIGNMENT == HORIZONTAL
-	LCD_WriteComm(0x2a);
-	LCD_WriteData2(y);
-	LCD_WriteData2(y+h-1);
-	LCD_WriteComm(0x2b);
-	LCD_WriteData2(x);
-	LCD_WriteData2(x+w-1);
+	LCD_InitBegin();
+	LCD_InitEnd();
+	LCD_DisplayOn();
+}
+
+static int lcd_wptr(unsigned short *px,unsigned short *py)
+{
+// メモリ書き込みの現在位置を求める
+// 位置を追跡できていない場合やウィンドウの終端まで書き込んだ場合は0を返す
+	unsigned int w,i;
+	if(!lcd_ramwr) return 0;
+	w=lcd_win[1]-lcd_win[0]+1;
+	i=(lcd_wptry-lcd_win[2])*w+(lcd_wptrx-lcd_win[0]);
+#if LCD_COLORMODE == LCD_COLOR12
+	i+=lcd_wbytes*2/3; //奇数画素の最後の2バイトも1画素として数える
+#elif LCD_COLORMODE == LCD_COLOR18
+	if(lcd_wbytes%3) return 0;
+	i+=lcd_wbytes/3;
+#else
+	if(lcd_wbytes&1) return 0;
+	i+=lcd_wbytes/2;
 #endif
-	LCD_WriteComm(0x2c);
+	if(i>=w*(lcd_win[3]-lcd_win[2]+1)) return 0;
+	*px=lcd_win[0]+i%w;
+	*py=lcd_win[2]+i/w;
+	return 1;
+}
+
+void LCD_TxWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+// トランザクション中にアドレスウィンドウを設定してメモリ書き込みを開始
+// 設定済みのウィンドウと同じ範囲のコマンドは送らない
+// 現在の書き込み位置からそのまま書ける場合はMemory Write Continueのみ送る
+	unsigned short x2,y2,px,py;
+	x2=x+w-1;
+	y2=y+h-1;
+	if(lcd_winvalid && lcd_wptr(&px,&py) && px==x && py==y &&
+		((h==1 && x2<=lcd_win[1]) || (x==lcd_win[0] && x2==lcd_win[1] && y2<=lcd_win[3]))){
+		lcd_comm(0x3c);
+		LCD_STAT(wincont,1);
+	}
+	else{
+		if(!lcd_winvalid || lcd_win[0]!=x || lcd_win[1]!=x2){
+			lcd_comm(0x2a);
+			LCD_TxData2(x);
+			LCD_TxData2(x2);
+			lcd_win[0]=x;
+			lcd_win[1]=x2;
+		}
+		else LCD_STAT(winskip,1);
+		if(!lcd_winvalid || lcd_win[2]!=y || lcd_win[3]!=y2){
+			lcd_comm(0x2b);
+			LCD_TxData2(y);
+			LCD_TxData2(y2);
+			lcd_win[2]=y;
+			lcd_win[3]=y2;
+		}
+		else LCD_STAT(winskip,1);
+		lcd_winvalid=1;
+		lcd_comm(0x2c);
+	}
+	lcd_ramwr=1;
+	lcd_wptrx=x;
+	lcd_wptry=y;
+	lcd_wbytes=0;
+}
+
+void LCD_setAddrWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+	LCD_TxBegin();
+	LCD_TxWindow(x,y,w,h);
+	LCD_TxEnd();
 }
 
 void LCD_SetCursor(unsigned short x, unsigned short y)
@@ -206,36 +588,81 @@ void LCD_SetCursor(unsigned short x, unsigned short y)
 	LCD_setAddrWindow(x,y,X_RES-x,1);
 }
 
+void LCD_Fill(unsigned short x,unsigned short y,unsigned short w,unsigned short h,unsigned short color)
+{
+	// (x,y)から横w*縦hの範囲をcolorで塗りつぶし
+	// DMA転送を開始してすぐに戻る。次の液晶アクセスまたはLCD_WaitDMA()で完了を待つ
+	if(w==0 || h==0) return;
+	LCD_TxBegin();
+	LCD_TxWindow(x,y,w,h);
+	lcd_dma_fill(color,w*h);
+	LCD_TxEnd();
+}
+
 void LCD_continuous_output(unsigned short x,unsigned short y,unsigned short color,int n)
 {
 	//High speed continuous output
-	int i;
-    unsigned short d;
-	LCD_setAddrWindow(x,y,n,1);
-	lcd_dc_hi();
-	lcd_cs_lo();
-	d=(color>>8) | (color<<8);
-	for (i=0; i < n ; i++){
-		spi_write_blocking(SPICH, (unsigned char *)&d, 2);
-	}
-	lcd_cs_hi();
+	if(n<=0) return;
+	LCD_Fill(x,y,n,1,color);
 }
 void LCD_Clear(unsigned short color)
 {
-	int i;
-    unsigned short d;
-	LCD_setAddrWindow(0,0,X_RES,Y_RES);
-	lcd_dc_hi();
-	lcd_cs_lo();
-	d=(color>>8) | (color<<8);
-	for (i=0; i < X_RES*Y_RES ; i++){
-		spi_write_blocking(SPICH, (unsigned char *)&d, 2);
-	}
-	lcd_cs_hi();
+	LCD_Fill(0,0,X_RES,Y_RES,color);
 }
 
 void drawPixel(unsigned short x, unsigned short y, unsigned short color)
 {
-	LCD_SetCursor(x,y);
-	LCD_WriteData2(color);
+	unsigned char b[LCD_PIXBYTES(1)];
+	LCD_TxBegin();
+	LCD_TxWindow(x,y,X_RES-x,1);
+	LCD_TxData(b,LCD_PackPixels(b,&color,1));
+	LCD_TxEnd();
+}
+
+void LCD_SetScroll(unsigned short s)
+{
+// 縦スクロール位置を設定（表示の先頭ラインにメモリのs行目を表示）
+	LCD_TxBegin();
+	LCD_TxComm(0x37);
+	LCD_TxData2(s);
+	LCD_TxEnd();
+	lcd_scroll=s;
+}
+
+int LCD_ScanDistance(unsigned short x,unsigned short y)
+{
+// 走査線が画面上の(x,y)のラインに到達するまでのライン数を返す
+// 横向きの場合はx方向が走査方向になる
+	uint32_t t;
+	int s,l;
+	t=(time_us_32()-lcd_tetime)%LCD_FRAME_US;
+	s=t*LCD_GRAMH/LCD_FRAME_US; //現在の走査ライン
+#if LCD_ALIGNMENT == VERTICAL
+	l=y;
+#else
+	l=x;
+#endif
+	l=(l+LCD_GRAMH-lcd_scroll)%LCD_GRAMH; //表示上のライン
+	return (l+LCD_GRAMH-s)%LCD_GRAMH;
+}
+
+void LCD_WaitScanOut(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+// (x,y)から横w*縦hの範囲を描画しても走査線と交差しないタイミングまで待つ
+// 走査線が範囲内にあるか、範囲の手前LCD_TE_MARGINライン以内にある場合は、範囲を通過するまで待つ
+	int d,n;
+	if(!lcd_displayon) return;
+	//送信済みのデータの転送完了を待つ（CSは解放しない）
+	lcd_qkick();
+	lcd_dma_wait();
+#if LCD_ALIGNMENT == VERTICAL
+	n=h;
+#else
+	n=w;
+#endif
+	while(1){
+		d=LCD_ScanDistance(x,y);
+		if(d>=LCD_TE_MARGIN && d<=LCD_GRAMH-n) break;
+		tight_loop_contents();
+	}
 }
@@ -0,0 +1,66 @@
+//画面レイアウトのタイルマップ（tools/mkscene.cで生成）
+//横SCENE_W*縦SCENE_Hセル、1セルを2バイトで表す。1バイト目:文字番号、2バイト目:カラー番号
+
+#include <stdint.h>
+#include "tetris.h"
+
+const unsigned char SceneTitle[SCENE_H*SCENE_W*2]={
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x53,5,0x43,5,0x4F,5,0x52,5,0x45,5,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x48,5,0x49,5,0x2D,5,0x53,5,0x43,5,0x4F,5,0x52,5,0x45,5,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x62,10,0x20,10,0x20,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x63,10,0x0A,4,0x0B,4,0x0C,4,0x0D,4,0x0E,4,0x0F,4,0x10,4,0x11,4,0x12,4,0x13,4,0x20,10,0x20,10,0x64,10,0x20,10,0x20,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x65,10,0x14,4,0x15,4,0x16,4,0x17,4,0x18,4,0x19,4,0x1A,4,0x1B,4,0x1C,4,0x1D,4,0x20,10,0x20,10,0x66,10,0x20,10,0x20,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x67,10,0x68,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x69,10,0x6A,10,0x20,10,0x20,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x6B,10,0x6C,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x6D,10,0x6E,10,0x6F,10,0x20,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x70,10,0x71,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x72,10,0x73,10,0x74,10,0x75,10,0x76,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x20,10,0x77,10,0x78,10,0x79,10,0x7A,10,0x7B,10,0x7C,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x7D,10,0x7E,10,0x7F,10,0x80,10,0x81,10,0x82,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x20,10,0x83,10,0x84,10,0x85,10,0x86,10,0x87,10,0x88,10,0x89,10,0x8A,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x8B,10,0x8C,10,0x8D,10,0x20,10,0x8E,10,0x8F,10,0x90,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x91,10,0x92,10,0x93,10,0x94,10,0x95,10,0x96,10,0x97,10,0x98,10,0x99,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x9A,10,0x9B,10,0x9C,10,0x20,10,0x9D,10,0x9E,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x20,10,0x9F,10,0xA0,10,0xA1,10,0xA2,10,0xA3,10,0xA4,10,0xA5,10,0xA6,10,0xA7,10,0xA8,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0xA9,10,0xAA,10,0xAB,10,0xAC,10,0xAD,10,0xAE,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0xAF,10,0xB0,10,0xB1,10,0xB2,10,0xB3,10,0xB4,10,0xB5,10,0xB6,10,0xB7,10,0xB8,10,0xB9,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0xBA,10,0xBB,10,0xBC,10,0xBD,10,0xBE,10,0xBF,10,0x20,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0xC0,10,0xC1,10,0xC2,10,0xC3,10,0xC4,10,0xC5,10,0xC6,10,0xC7,10,0xC8,10,0xC9,10,0xCA,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0xCB,10,0xCC,10,0xCD,10,0xCE,10,0xCF,10,0xD0,10,0xD1,10,0x20,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0xD2,10,0xD3,10,0xD4,10,0xD5,10,0xD6,10,0xD7,10,0xD8,10,0xD9,10,0xDA,10,0xDB,10,0xDC,10,0xDD,10,0x20,10,0xDE,10,0xDF,10,0xE0,10,0xE1,10,0xE2,10,0xE3,10,0xE4,10,0xE5,10,0xE6,10,0xE7,10,0xE8,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0xE9,10,0xEA,10,0xEB,10,0xEC,10,0xED,10,0xEE,10,0xEF,10,0xF0,10,0xF1,10,0xF2,10,0xF3,10,0xF4,10,0xF5,10,0xF6,10,0x20,10,0xF7,10,0xF8,10,0xF9,10,0xFA,10,0xFB,10,0xFC,10,0xFD,10,0xFE,10,0xFF,10,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x4C,5,0x45,5,0x46,5,0x54,5,0x20,5,0x20,5,0x20,5,0x5C,5,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x54,7,0x45,7,0x54,7,0x52,7,0x49,7,0x53,7,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x52,5,0x49,5,0x47,5,0x48,5,0x54,5,0x20,5,0x20,5,0x5B,5,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x46,7,0x4F,7,0x52,7,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x52,5,0x4F,5,0x54,5,0x41,5,0x54,5,0x45,5,0x20,5,0x1E,5,0x00,0,0x00,0,0x00,0,0x00,0,0x52,7,0x41,7,0x53,7,0x50,7,0x42,7,0x45,7,0x52,7,0x52,7,0x59,7,0x20,7,0x50,7,0x49,7,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x44,5,0x4F,5,0x57,5,0x4E,5,0x20,5,0x20,5,0x20,5,0x1F,5,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x50,7,0x49,7,0x43,7,0x4F,7,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x5E,7,0x4B,7,0x45,7,0x4E,7,0x4B,7,0x45,7,0x4E,7,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x50,6,0x55,6,0x53,6,0x48,6,0x20,6,0x53,6,0x54,6,0x41,6,0x52,6,0x54,6,0x20,6,0x42,6,0x55,6,0x54,6,0x54,6,0x4F,6,0x4E,6,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+};
+
+const unsigned char SceneGame[SCENE_H*SCENE_W*2]={
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x20,10,0x20,10,0x20,10,0x62,10,0x20,10,0x20,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x63,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x20,10,0x20,10,0x20,10,0x64,10,0x20,10,0x20,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x65,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x20,10,0x20,10,0x20,10,0x66,10,0x20,10,0x20,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x67,10,0x68,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x20,10,0x20,10,0x69,10,0x6A,10,0x20,10,0x20,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x6B,10,0x6C,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x20,10,0x20,10,0x6D,10,0x6E,10,0x6F,10,0x20,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x20,10,0x20,10,0x70,10,0x71,10,0x20,10,0x20,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x20,10,0x72,10,0x73,10,0x74,10,0x75,10,0x76,10,0x20,10,
+	0x20,10,0x20,10,0x20,10,0x77,10,0x78,10,0x79,10,0x7A,10,0x7B,10,0x7C,10,0x20,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x7D,10,0x7E,10,0x7F,10,0x80,10,0x81,10,0x82,10,0x20,10,
+	0x20,10,0x20,10,0x83,10,0x84,10,0x85,10,0x86,10,0x87,10,0x88,10,0x89,10,0x8A,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x8B,10,0x8C,10,0x8D,10,0x20,10,0x8E,10,0x8F,10,0x90,10,
+	0x20,10,0x91,10,0x92,10,0x93,10,0x94,10,0x95,10,0x96,10,0x97,10,0x98,10,0x99,10,0x20,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x9A,10,0x9B,10,0x9C,10,0x20,10,0x9D,10,0x9E,10,0x20,10,
+	0x20,10,0x9F,10,0xA0,10,0xA1,10,0xA2,10,0xA3,10,0xA4,10,0xA5,10,0xA6,10,0xA7,10,0xA8,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0xA9,10,0xAA,10,0xAB,10,0xAC,10,0xAD,10,0xAE,10,0x20,10,
+	0xAF,10,0xB0,10,0xB1,10,0xB2,10,0xB3,10,0xB4,10,0xB5,10,0xB6,10,0xB7,10,0xB8,10,0xB9,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0xBA,10,0xBB,10,0xBC,10,0xBD,10,0xBE,10,0xBF,10,0x20,10,
+	0xC0,10,0xC1,10,0xC2,10,0xC3,10,0xC4,10,0xC5,10,0xC6,10,0xC7,10,0xC8,10,0xC9,10,0xCA,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0xCB,10,0xCC,10,0xCD,10,0xCE,10,0xCF,10,0xD0,10,0xD1,10,
+	0xD2,10,0xD3,10,0xD4,10,0xD5,10,0xD6,10,0xD7,10,0xD8,10,0xD9,10,0xDA,10,0xDB,10,0xDC,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0xE1,10,0xE2,10,0xE3,10,0xE4,10,0xE5,10,0xE6,10,0xE7,10,
+	0xE9,10,0xEA,10,0xEB,10,0xEC,10,0xED,10,0xEE,10,0xEF,10,0xF0,10,0xF1,10,0xF2,10,0xF3,10,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0xF8,10,0xF9,10,0xFA,10,0xFB,10,0xFC,10,0xFD,10,0xFE,10,
+	0x04,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x08,4,0x00,0,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,
+	0x05,4,0x00,0,0x53,7,0x43,7,0x4F,7,0x52,7,0x45,7,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x04,4,0x07,4,0x07,4,0x07,4,0x07,4,0x08,4,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,
+	0x05,4,0x48,7,0x49,7,0x2D,7,0x53,7,0x43,7,0x4F,7,0x52,7,0x45,7,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x4E,7,0x45,7,0x58,7,0x54,7,0x05,4,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,
+	0x05,4,0x00,0,0x4C,7,0x49,7,0x4E,7,0x45,7,0x53,7,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x02,9,0x03,11,0x06,4,0x07,4,0x07,4,0x07,4,0x07,4,0x09,4,
+	0x05,4,0x00,0,0x4C,7,0x45,7,0x56,7,0x45,7,0x4C,7,0x00,0,0x00,0,0x05,4,0x03,11,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x02,9,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,
+	0x05,4,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x00,0,0x05,4,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,
+	0x06,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x07,4,0x09,4,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,0x03,11,
+};
+
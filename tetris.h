@@ -2,6 +2,10 @@
 
 #define SCENECLEARLINE 20 //ステージクリアの消去ライン数
 
+//画面レイアウトのタイルマップの大きさ（文字単位）
+#define SCENE_W 30
+#define SCENE_H 27
+
 //各種キャラクターコード定義
 #define CODE_BLOCK 0x01
 #define CODE_WALL 0x02
@@ -22,7 +26,8 @@
 #define COLOR_BRICK 11
 #define COLOR_FRAME 4
 #define COLOR_SPACE 0
-#define COLOR_CLEARBLOCK 7
+#define COLOR_CLEARBLOCK 12 //パレットアニメーションで点滅させるため専用のカラー番号
+#define CLEARFADE_FRAMES 8 //消去するラインを白くするまでのフレーム数（消去までは15フレーム）
 
 #define SOUNDDONGLENGTH 7
 
@@ -46,3 +51,5 @@ typedef struct {
 } _Music;
 
 extern const unsigned char FontData[256*8];
+extern const unsigned char SceneTitle[SCENE_H*SCENE_W*2]; //タイトル画面（scenes.c）
+extern const unsigned char SceneGame[SCENE_H*SCENE_W*2]; //ゲーム画面（scenes.c）
@@ -1,10 +1,12 @@
 // テトリス（カラーグラフィック液晶版） Tetris for Raspberry Pi Pico by K.Tanaka
 
-// LCD : ILI9341 (240x340) SPI I/F
+// LCD : ILI9341 (240x320) SPI I/F
+//       ST7789 (240x240/240x320)、ILI9488 (320x480) はLCDdriver.hのLCD_CONTROLLERで選択
 //  Pico         LCD
 //  GPIO11       CS
 //  GPIO12       DC
 //  GPIO13       RESET
+//  (GPIOx        TE)    接続する場合はLCDdriver.hのLCD_TEを設定
 //  GPIO18(SCK)  CLK
 //  GPIO19(MOSI) MOSI
 //  GND          GND
@@ -20,6 +22,7 @@
 
 // スピーカー GPIO6
 
+#include <stdio.h>
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
@@ -45,10 +48,29 @@
 
 #define SOUNDPORT 6
 
-#define clearscreen() LCD_Clear(0)
+#define clearscreen() cleartiles(0)
+#define PALANIM_BUDGET 64 //パレットアニメーションで1フレームに再描画するセル数の上限
+
+// ゲーム画面のキャラクター配置（横GAME_W*縦GAME_H文字）を画面中央に置く
+#define CELL FONTSIZE //1文字の表示サイズ（ドット）
+#define GAME_W SCENE_W
+#define GAME_H SCENE_H
+#if GAME_W*CELL>X_RES || GAME_H*CELL>Y_RES
+#error "Game screen (30x27 cells) does not fit in LCD: tetrispico supports LCD_SCALE 1 only"
+#endif
+#define GAME_X0 ((X_RES-GAME_W*CELL)/2)
+#if LCD_ALIGNMENT == VERTICAL && Y_RES == LCD_GRAMH
+// 画面全体が液晶のメモリに対応する場合は、縦方向は縦スクロール機能で中央に寄せる
+#define GAME_Y0 0
+#define GAME_SCROLL (LCD_GRAMH-(Y_RES/CELL-GAME_H)/2*CELL)
+#else
+#define GAME_Y0 ((Y_RES-GAME_H*CELL)/2)
+#endif
 
 unsigned char cursorx,cursory,cursorc;
-unsigned char board[25][12]; //ブロックを配置する配列
+unsigned char board[25][12]; //ブロックを配置する配列（各セルの色、表示にのみ使用）
+unsigned short boardbits[25]; //各行のブロックの有無（ビットxがx列目）、当たり判定とライン判定に使用
+#define LINE_FULL 0x7FE //壁を除く1〜10列が全て埋まった行のboardbits
 unsigned char boardchange[25][12]; //board配列が変化したかを表す配列
 unsigned int score,highscore; //得点、ハイスコア
 unsigned int gcount=0; //カウンタ、乱数の種に使用
@@ -68,19 +90,58 @@ unsigned char gamestatus;
 unsigned char lines;//消去したライン累積数
 const unsigned int scorearray[]={40,100,300,1200}; //同時消去したライン数による得点
 
-//ブロックの形状、色、向きの初期値定義
-const _Block block[7]={
-	{1, 0,-1, 0,-2, 0, COLOR_IBLOCK, 1},//I
-	{1, 0,-1, 0,-1,-1, COLOR_JBLOCK, 3},//J
-	{1, 0, 1,-1,-1, 0, COLOR_LBLOCK, 3},//L
-	{1, 0, 0,-1,-1,-1, COLOR_ZBLOCK, 1},//Z
-	{0,-1, 1,-1,-1, 0, COLOR_SBLOCK, 1},//S
-	{0,-1,-1, 0,-1,-1, COLOR_OBLOCK, 0},//O
-	{1, 0, 0,-1,-1, 0, COLOR_TBLOCK, 3} //T
+//ブロックの形状、色、回転可能回数の定義（7種類×4方向）
+//blockrot[n][0]が出現時の向き、blockrot[n][a+1]はblockrot[n][a]を軸中心に90度回転したもの
+//向きがrotを越えると初期位置のblockrot[n][0]に戻す
+const _Block blockrot[7][4]={
+	{ //I
+		{ 1, 0,-1, 0,-2, 0, COLOR_IBLOCK, 1},
+		{ 0, 1, 0,-1, 0,-2, COLOR_IBLOCK, 1},
+		{-1, 0, 1, 0, 2, 0, COLOR_IBLOCK, 1},
+		{ 0,-1, 0, 1, 0, 2, COLOR_IBLOCK, 1}
+	},
+	{ //J
+		{ 1, 0,-1, 0,-1,-1, COLOR_JBLOCK, 3},
+		{ 0, 1, 0,-1, 1,-1, COLOR_JBLOCK, 3},
+		{-1, 0, 1, 0, 1, 1, COLOR_JBLOCK, 3},
+		{ 0,-1, 0, 1,-1, 1, COLOR_JBLOCK, 3}
+	},
+	{ //L
+		{ 1, 0, 1,-1,-1, 0, COLOR_LBLOCK, 3},
+		{ 0, 1, 1, 1, 0,-1, COLOR_LBLOCK, 3},
+		{-1, 0,-1, 1, 1, 0, COLOR_LBLOCK, 3},
+		{ 0,-1,-1,-1, 0, 1, COLOR_LBLOCK, 3}
+	},
+	{ //Z
+		{ 1, 0, 0,-1,-1,-1, COLOR_ZBLOCK, 1},
+		{ 0, 1, 1, 0, 1,-1, COLOR_ZBLOCK, 1},
+		{-1, 0, 0, 1, 1, 1, COLOR_ZBLOCK, 1},
+		{ 0,-1,-1, 0,-1, 1, COLOR_ZBLOCK, 1}
+	},
+	{ //S
+		{ 0,-1, 1,-1,-1, 0, COLOR_SBLOCK, 1},
+		{ 1, 0, 1, 1, 0,-1, COLOR_SBLOCK, 1},
+		{ 0, 1,-1, 1, 1, 0, COLOR_SBLOCK, 1},
+		{-1, 0,-1,-1, 0, 1, COLOR_SBLOCK, 1}
+	},
+	{ //O
+		{ 0,-1,-1, 0,-1,-1, COLOR_OBLOCK, 0},
+		{ 1, 0, 0,-1, 1,-1, COLOR_OBLOCK, 0},
+		{ 0, 1, 1, 0, 1, 1, COLOR_OBLOCK, 0},
+		{-1, 0, 0, 1,-1, 1, COLOR_OBLOCK, 0}
+	},
+	{ //T
+		{ 1, 0, 0,-1,-1, 0, COLOR_TBLOCK, 3},
+		{ 0, 1, 1, 0, 0,-1, COLOR_TBLOCK, 3},
+		{-1, 0, 0, 1, 1, 0, COLOR_TBLOCK, 3},
+		{ 0,-1,-1, 0, 0, 1, COLOR_TBLOCK, 3}
+	}
 };
 
-_Block falling; //現在落下中のブロックの構造体
+const _Block *falling; //現在落下中のブロック（blockrot配列の要素）
 unsigned char blockx,blocky,blockangle,blockno; //現在落下中のブロックの座標、向き、種類
+const _Block *overlay; //画面に表示中の落下中のブロック（board配列には書き込まず、表示時に重ねる）
+unsigned char overlayx,overlayy,overlayon; //表示中の落下中のブロックの座標、表示中なら1
 
 _Music music; //演奏中の音楽構造体
 const unsigned short *sounddatap; //ブロック着地効果音配列の位置、演奏中の音楽よりこちらを優先
@@ -179,24 +240,6 @@ const unsigned short soundDong[5][SOUNDDONGLENGTH]={
 	{16000,14000,12500,11000,9500,8000,0} //4行クリアの音
 };
 
-//背景画像コード 横24×縦14キャラクター
-const unsigned char bitmap1[]={
-	0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x62,0x20,0x20,0x20,0x20,
-	0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x20,0x20,0x20,0x20,
-	0x20,0x20,0x20,0x20,0x20,0x20,0x65,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x20,0x20,0x20,0x20,
-	0x20,0x20,0x20,0x20,0x20,0x67,0x68,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6a,0x20,0x20,0x20,0x20,
-	0x20,0x20,0x20,0x20,0x20,0x6b,0x6c,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6e,0x6f,0x20,0x20,0x20,
-	0x20,0x20,0x20,0x20,0x20,0x70,0x71,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x72,0x73,0x74,0x75,0x76,0x20,0x20,
-	0x20,0x20,0x20,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x7e,0x7f,0x80,0x81,0x82,0x20,0x20,
-	0x20,0x20,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x20,0x20,0x20,0x20,0x20,0x20,0x8b,0x8c,0x8d,0x20,0x8e,0x8f,0x90,0x20,
-	0x20,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x20,0x20,0x20,0x20,0x20,0x20,0x9a,0x9b,0x9c,0x20,0x9d,0x9e,0x20,0x20,
-	0x20,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0x20,0x20,0x20,0x20,0x20,0xa9,0xaa,0xab,0xac,0xad,0xae,0x20,0x20,
-	0xaf,0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0x20,0x20,0x20,0x20,0x20,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0x20,0x20,
-	0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0x20,0x20,0x20,0x20,0x20,0xcb,0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0x20,
-	0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0x20,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,
-	0xe9,0xea,0xeb,0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0x20,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
-};
-
 #define PWM_WRAP 4000 // 125MHz/31.25KHz
 uint pwm_slice_num;
 
@@ -210,6 +253,8 @@ void sound_off(void){
 
 void wait60thsec(unsigned short n){
 	// 60分のn秒ウェイト
+	animpalette(PALANIM_BUDGET);
+	flushtiles();
 	uint64_t t=to_us_since_boot(get_absolute_time())%16667;
 	sleep_us(16667*n-t);
 }
@@ -217,6 +262,7 @@ unsigned char startkeycheck(unsigned short n){
 	// 60分のn秒ウェイト
 	// スタートボタンが押されればすぐ戻る
 	//　戻り値　スタートボタン押されれば1、押されなければ0
+	flushtiles();
 	uint64_t t=to_us_since_boot(get_absolute_time())%16667;
 	while(n--){
 		sleep_us(16667-t);
@@ -284,19 +330,20 @@ void stopmusic(void){
 
 void locate(unsigned char x,unsigned char y,unsigned char c){
 	//カーソルを座標(x,y)にカラー番号cに設定
-	cursorx=x*8;
-	cursory=y*8;
+	cursorx=x;
+	cursory=y;
 	cursorc=c;
 }
 void printchar2(unsigned char n){
 	//カーソル位置、設定カラーでテキストコードnを1文字表示
-	putfont(cursorx,cursory,cursorc,0,n);
-	cursorx+=8;
-	if(cursorx>=X_RES){
+	//タイルマップに書き込み、液晶にはflushtiles()でまとめて送信する
+	puttile(cursorx,cursory,cursorc,0,n);
+	cursorx++;
+	if(cursorx>=GAME_W){
 		cursorx=0;
-		cursory+=8;
+		cursory++;
 	}
-	if(cursory>=Y_RES) cursory=0;
+	if(cursory>=(Y_RES-GAME_Y0)/CELL) cursory=0;
 }
 void printchar(unsigned char x,unsigned char y,unsigned char c,unsigned char n){
 	//キャラクター座標(x,y)にカラー番号cでテキストコードnを1文字表示
@@ -323,7 +370,7 @@ void printnumber6(unsigned char x,unsigned char y,unsigned char c,unsigned int s
 void printnext(void){
 //NEXTエリアに次のブロックを表示
 	const _Block *bp;
-	bp=&block[next];
+	bp=&blockrot[next][0];
 	printstr2(25,19,0,"    ");
 	printstr2(25,20,0,"    ");
 	printstr2(25,21,0,"    ");
@@ -334,83 +381,120 @@ void printnext(void){
 	printchar(27+bp->x3,21+bp->y3,bp->color,CODE_BLOCK);
 }
 
+unsigned char cellcolor(int8_t x,int8_t y){
+//board配列に落下中のブロックを重ねた、座標(x,y)の色
+	const _Block *bp;
+	int8_t dx,dy;
+	if(overlayon){
+		bp=overlay;
+		dx=x-overlayx;
+		dy=y-overlayy;
+		if((dx==0 && dy==0) || (dx==bp->x1 && dy==bp->y1) || (dx==bp->x2 && dy==bp->y2) || (dx==bp->x3 && dy==bp->y3))
+			return bp->color;
+	}
+	return board[y][x];
+}
 void show(void){
-//board配列の内容を画面に表示
-	int8_t x,y;
+//board配列に落下中のブロックを重ねて画面に表示
+//走査線が近づいてくる順に行を描画し、描画中の行を走査線が通過しないようにする
+	int8_t x,y,y0,i;
+	int d,dmin;
+	//走査線が次に到達する行（手前LCD_TE_MARGINライン以内の行を除く）から描画を始める
+	y0=1;
+	dmin=LCD_GRAMH;
 	for(y=1;y<=23;y++){
+		d=LCD_ScanDistance(GAME_X0+12*CELL,GAME_Y0+y*CELL);
+		if(d>=LCD_TE_MARGIN && d<dmin){
+			dmin=d;
+			y0=y;
+		}
+	}
+	y=y0;
+	for(i=0;i<23;i++){
 		for(x=1;x<=10;x++){
-			if(boardchange[y][x]){
-				printchar(11+x,y,board[y][x],CODE_BLOCK);
-				boardchange[y][x]=0;
+			if(boardchange[y][x]) break;
+		}
+		if(x<=10){
+			for(;x<=10;x++){
+				if(boardchange[y][x]){
+					printchar(11+x,y,cellcolor(x,y),CODE_BLOCK);
+					boardchange[y][x]=0;
+				}
 			}
+			LCD_WaitScanOut(GAME_X0+12*CELL,GAME_Y0+y*CELL,10*CELL,CELL);
+			flushtilerows(y,y);
 		}
+		if(++y>23) y=1;
 	}
+	flushtiles(); //得点表示など残りのセル
 }
 void displayscore(void){
 //得点表示
 	printnumber6(0,16,7,score);
 	printnumber6(0,19,7,highscore);
 }
-int check(_Block *bp,int8_t x,int8_t y){
+int check(const _Block *bp,int8_t x,int8_t y){
 //x,yの位置に_Block構造体bl（ポインタ渡し）をおけるかチェック
+//board配列には落下中のブロック自身は含まれない
+//boardbits配列の各行とセルのビットのANDで判定する
 //戻り値　0:おける　-1:おけない
-	if(board[y][x]) return -1;
-	if(board[y+bp->y1][x+bp->x1]) return -1;
-	if(board[y+bp->y2][x+bp->x2]) return -1;
-	if(board[y+bp->y3][x+bp->x3]) return -1;
+	//壁を含む0〜11列の範囲外にはみ出すセルがある場合は、シフトする前に置けないと判定する
+	if((unsigned)x>11 || (unsigned)(x+bp->x1)>11
+		|| (unsigned)(x+bp->x2)>11 || (unsigned)(x+bp->x3)>11) return -1;
+	if((boardbits[y]&(1<<x))
+		|| (boardbits[y+bp->y1]&(1<<(x+bp->x1)))
+		|| (boardbits[y+bp->y2]&(1<<(x+bp->x2)))
+		|| (boardbits[y+bp->y3]&(1<<(x+bp->x3)))) return -1;
 	return 0;
 }
+void markblock(const _Block *bp,int8_t x,int8_t y){
+//座標(x,y)に置いた_Block構造体bp（ポインタ渡し）の4つのセルを再表示の対象にする
+	boardchange[y][x]=1;
+	boardchange[y+bp->y1][x+bp->x1]=1;
+	boardchange[y+bp->y2][x+bp->x2]=1;
+	boardchange[y+bp->y3][x+bp->x3]=1;
+}
 void putblock(void){
-//board配列に落下中のブロックを書き込み
-	_Block *bp;
-	bp=&falling;
+//着地した落下中のブロックをboard配列とboardbits配列に書き込み
+	const _Block *bp;
+	bp=falling;
 	board[blocky][blockx]=bp->color;
 	board[blocky+bp->y1][blockx+bp->x1]=bp->color;
 	board[blocky+bp->y2][blockx+bp->x2]=bp->color;
 	board[blocky+bp->y3][blockx+bp->x3]=bp->color;
-
-	boardchange[blocky][blockx]=1;
-	boardchange[blocky+bp->y1][blockx+bp->x1]=1;
-	boardchange[blocky+bp->y2][blockx+bp->x2]=1;
-	boardchange[blocky+bp->y3][blockx+bp->x3]=1;
-}
-void eraseblock(void){
-//board配列から落下中のブロックを消去
-	_Block *bp;
-	bp=&falling;
-	board[blocky][blockx]=COLOR_SPACE;
-	board[blocky+bp->y1][blockx+bp->x1]=COLOR_SPACE;
-	board[blocky+bp->y2][blockx+bp->x2]=COLOR_SPACE;
-	board[blocky+bp->y3][blockx+bp->x3]=COLOR_SPACE;
-
-	boardchange[blocky][blockx]=1;
-	boardchange[blocky+bp->y1][blockx+bp->x1]=1;
-	boardchange[blocky+bp->y2][blockx+bp->x2]=1;
-	boardchange[blocky+bp->y3][blockx+bp->x3]=1;
+	boardbits[blocky]|=1<<blockx;
+	boardbits[blocky+bp->y1]|=1<<(blockx+bp->x1);
+	boardbits[blocky+bp->y2]|=1<<(blockx+bp->x2);
+	boardbits[blocky+bp->y3]|=1<<(blockx+bp->x3);
+	markblock(bp,blockx,blocky);
+}
+void setoverlay(unsigned char on){
+//表示する落下中のブロックを現在の位置と形に更新、on=0の場合は表示しない
+//位置と形が変わっていなければ再表示の対象にするセルはない
+	if(on==overlayon){
+		if(on==0) return;
+		if(blockx==overlayx && blocky==overlayy && falling==overlay) return;
+	}
+	if(overlayon) markblock(overlay,overlayx,overlayy);
+	overlay=falling;
+	overlayx=blockx;
+	overlayy=blocky;
+	overlayon=on;
+	if(on) markblock(overlay,overlayx,overlayy);
 }
 int newblock(void){
 //次のブロック出現
 //戻り値：通常0、置けなければ-1（ゲームオーバー）
-	const _Block *blockp;
-
-	blockp=&block[next];
-	falling.x1=blockp->x1;
-	falling.y1=blockp->y1;
-	falling.x2=blockp->x2;
-	falling.y2=blockp->y2;
-	falling.x3=blockp->x3;
-	falling.y3=blockp->y3;
-	falling.color=blockp->color;
-	falling.rot=blockp->rot;
+	falling=&blockrot[next][0];
 	blockx=6;
 	blocky=3;
 	blockangle=0;
 	blockno=next;
 	fallcount=fallspeed;
 	next=rand()%7;
-	if(check(&falling,blockx,blocky)) return -1;
+	if(check(falling,blockx,blocky)) return -1;
 	printnext(); //NEXTの場所に次のブロック表示
-	putblock(); //落下開始のブロック配置
+	setoverlay(1); //落下開始のブロック表示
 	downkeyrepeat=0; //下キーのリピートを阻止
 	return 0;
 }
@@ -430,8 +514,8 @@ void moveblock(void){
 //落下できない場合はgamestatus=1とする
 
 	unsigned short k;
-	_Block tempblock;
-	const _Block *blockp;
+	const _Block *bp;
+	unsigned char angle;
 	int8_t movedflag;
 
 	movedflag=0;
@@ -439,54 +523,25 @@ void moveblock(void){
 	// ボタンチェック
 	k=~gpio_get_all() & KEYSMASK;
 	if(keyold!=KEYUP && k==KEYUP){	//上ボタン（回転）
-		if(blockangle<falling.rot){ //軸中心に90度回転
-			tempblock.x1=-falling.y1;
-			tempblock.y1= falling.x1;
-			tempblock.x2=-falling.y2;
-			tempblock.y2= falling.x2;
-			tempblock.x3=-falling.y3;
-			tempblock.y3= falling.x3;
-			if(check(&tempblock,blockx,blocky)==0){
-				falling.x1=tempblock.x1;
-				falling.y1=tempblock.y1;
-				falling.x2=tempblock.x2;
-				falling.y2=tempblock.y2;
-				falling.x3=tempblock.x3;
-				falling.y3=tempblock.y3;
-				blockangle++;
-				movedflag=-1;
-			}
-		}
-		else{ //回転を初期位置に戻す場合
-			blockp=&block[blockno];
-			tempblock.x1=blockp->x1;
-			tempblock.y1=blockp->y1;
-			tempblock.x2=blockp->x2;
-			tempblock.y2=blockp->y2;
-			tempblock.x3=blockp->x3;
-			tempblock.y3=blockp->y3;
-			if(check(&tempblock,blockx,blocky)==0){
-				falling.x1=tempblock.x1;
-				falling.y1=tempblock.y1;
-				falling.x2=tempblock.x2;
-				falling.y2=tempblock.y2;
-				falling.x3=tempblock.x3;
-				falling.y3=tempblock.y3;
-				blockangle=0;
-				movedflag=-1;
-			}
+		//軸中心に90度回転、回転可能回数を越える場合は初期位置に戻す
+		angle=(blockangle<falling->rot)?blockangle+1:0;
+		bp=&blockrot[blockno][angle];
+		if(check(bp,blockx,blocky)==0){
+			falling=bp;
+			blockangle=angle;
+			movedflag=-1;
 		}
 	}
 	else if(keyold!=KEYRIGHT && k==KEYRIGHT){	//右ボタン
-		if(check(&falling,blockx+1,blocky)==0) blockx++;
+		if(check(falling,blockx+1,blocky)==0) blockx++;
 		movedflag=-1;
 	}
 	else if(keyold!=KEYLEFT && k==KEYLEFT){	//左ボタン
-		if(check(&falling,blockx-1,blocky)==0) blockx--;
+		if(check(falling,blockx-1,blocky)==0) blockx--;
 		movedflag=-1;
 	}
 	else if(downkeyrepeat && k==KEYDOWN){	//下ボタン
-		if(check(&falling,blockx,blocky+1)==0){
+		if(check(falling,blockx,blocky+1)==0){
 			blocky++;
 			movedflag=-1;
 			score++;
@@ -503,14 +558,14 @@ void moveblock(void){
 	fallcount--;
 	if(fallcount==0){ //自然落下
 		fallcount=fallspeed;
-		if(check(&falling,blockx,blocky+1)) gamestatus=1; //着地完了（固定）
+		if(check(falling,blockx,blocky+1)) gamestatus=1; //着地完了（固定）
 		else{
 			blocky++;
 			movedflag=-1;
 		}
 	}
 	if(movedflag){
-		if(check(&falling,blockx,blocky+1)){
+		if(check(falling,blockx,blocky+1)){
 			sounddatap=soundDong[0]; //着地音
 		}
 	}
@@ -518,18 +573,15 @@ void moveblock(void){
 
 void linecheck(void){
 //完成ラインのチェックと消去、得点加算
-	int8_t x,y,x2,y2,c,cleared,cleared2;
+	int8_t x,y,x2,y2,cleared,cleared2;
 
-	//消去するラインがあれば白いブロックに変更
+	//消去するラインがあれば灰色のブロックに変更
 	cleared=0;
 	y=blocky+2;
 	if(y>23) y=23;
 	while(y>=blocky-2){
-		c=0;
-		for(x=1;x<=10;x++){
-			if(board[y][x]) c++;
-		}
-		if(c==10){
+		if((boardbits[y]&LINE_FULL)==LINE_FULL){
+			if(cleared==0) set_palette(COLOR_CLEARBLOCK,128,128,128);
 			cleared++;
 			locate(12,y,COLOR_CLEARBLOCK);
 			for(x=1;x<=10;x++) printchar2(CODE_CLEARBLOCK);
@@ -538,6 +590,8 @@ void linecheck(void){
 	}
 	if(cleared==0) return;
 
+	//パレットアニメーションで灰色から明るくしていき、後半は以前と同じ白いブロックで点灯させる
+	fadepalette(COLOR_CLEARBLOCK,255,255,255,CLEARFADE_FRAMES);
 	wait60thsecmusic(15); //60分の15秒待ち
 
 	//白いブロックの行を消去して、一番上に獲得した得点表示
@@ -545,11 +599,7 @@ void linecheck(void){
 	if(y>23) y=23;
 	cleared2=cleared;
 	while(cleared2>0){
-		c=0;
-		for(x=1;x<=10;x++){
-			if(board[y][x]) c++;
-		}
-		if(c==10){
+		if((boardbits[y]&LINE_FULL)==LINE_FULL){
 			printstr2(12,y,0,"          ");
 			cleared2--;
 		}
@@ -564,13 +614,10 @@ void linecheck(void){
 	y=blocky+2;
 	if(y>23) y=23;
 	while(y>=blocky-2 && cleared<4){
-		c=0;
-		for(x=1;x<=10;x++){
-			if(board[y][x]) c++;
-		}
-		if(c==10){
+		if((boardbits[y]&LINE_FULL)==LINE_FULL){
 			cleared++;
 			for(y2=y;y2>0;y2--){
+				boardbits[y2]=boardbits[y2-1];
 				for(x2=1;x2<=10;x2++){
 					board[y2][x2]=board[y2-1][x2];
 					boardchange[y2][x2]=1;
@@ -619,75 +666,19 @@ void gameinit2(void){
 //ゲームスタートボタン押下後に呼ばれる初期化
 	int i;
 	unsigned char y;
-	const unsigned char *p;
 	score=0;
 	level=0;
 	fallspeed=60;
+	//レンガ、背景画像、得点表示枠、NEXT表示枠、壁はscenes.cのタイルマップをまとめて書き込む
 	clearscreen();
-	locate(0,15,COLOR_BRICK);
-	for(i=0;i<12*30;i++) printchar2(CODE_BRICK);
-
-// 背景表示
-	p=bitmap1;
-	for(y=0;y<=13;y++){
-		locate(0,y,COLOR_BITMAP);
-		for(i=0;i<=10;i++) printchar2(*p++);
-		p+=13;
-	}
-	p=bitmap1+16;
-	for(y=0;y<=13;y++){
-		locate(23,y,COLOR_BITMAP);
-		for(i=23;i<=29;i++) printchar2(*p++);
-		p+=17;
-	}
-
-// 得点表示枠を描画
-	printchar(0,14,COLOR_FRAME,0x04);
-	for(i=1;i<=8;i++) printchar2(0x07);
-	printchar2(0x08);
-	for(y=15;y<=25;y++){
-		printchar(0,y,COLOR_FRAME,0x05);
-		printstr2(1,y,COLOR_FRAME,"        ");
-		printchar2(0x05);
-	}
-	printchar(0,26,COLOR_FRAME,0x06);
-	for(i=1;i<=8;i++) printchar2(0x07);
-	printchar2(0x09);
-
-	printstr2(2,15,7,"SCORE");
-	printstr2(1,18,7,"HI-SCORE");
-	printstr2(2,21,7,"LINES");
-	printstr2(2,24,7,"LEVEL");
-
-//NEXT表示枠を描画
-	printchar(24,16,COLOR_FRAME,0x04);
-	for(i=1;i<=4;i++) printchar2(0x07);
-	printchar2(0x08);
-	for(y=17;y<=22;y++){
-		printchar(24,y,COLOR_FRAME,0x05);
-		printstr2(25,y,COLOR_FRAME,"    ");
-		printchar2(0x05);
-	}
-	printchar(24,23,COLOR_FRAME,0x06);
-	for(i=1;i<=4;i++) printchar2(0x07);
-	printchar2(0x09);
-	printstr2(25,18,7,"NEXT");
-
-	locate(11,0,COLOR_WALL);
-	for(i=11;i<=22;i++) printchar2(CODE_WALL);
-	for(y=1;y<=23;y++){
-		printchar(11,y,COLOR_WALL,CODE_WALL);
-		for(i=12;i<=21;i++) printchar2(' ');
-		printchar(22,y,COLOR_WALL,CODE_WALL);
-	}
-	locate(11,24,COLOR_WALL);
-	for(i=11;i<=22;i++) printchar2(CODE_WALL);
+	puttilemap(0,0,GAME_W,GAME_H,0,SceneGame);
 	displayscore();
 	next=rand()%7;
 	printnext(); //NEXTの場所に次のブロック表示
 	sounddatap=soundDong[0]+SOUNDDONGLENGTH-1;
 
 	//ゲームエリアの初期化
+	for(y=0;y<25;y++) boardbits[y]=(y==24)?0xFFF:0x801; //壁と床のみ
 	for(i=0;i<12;i++) {
 		for(y=0;y<25;y++) {
 			if(i==0 || i==11 || y==24) {
@@ -698,6 +689,7 @@ void gameinit2(void){
 			}
 		}
 	}
+	flushtiles();
 }
 
 void gameinit3(void){
@@ -729,42 +721,19 @@ void gameover(void){
 }
 void title(void){
 	//タイトル画面表示
-	unsigned char x,y,c;
-	const unsigned char *p;
+	static unsigned char booted;
+	//背景画像、タイトルロゴ、説明文はscenes.cのタイルマップをまとめて書き込む
 	clearscreen();
-
-	//背景画像表示
-	p=bitmap1;
-	for(y=0;y<14;y++){
-		locate(3,y+3,COLOR_BITMAP);
-		for(x=0;x<24;x++){
-			printchar2(*p++);
-		}
-	}
-
-	//タイトルロゴ表示
-	c=0x0a;
-	locate(10,4,4);
-	for(x=1;x<=10;x++) printchar2(c++);
-	locate(10,5,4);
-	for(x=1;x<=10;x++) printchar2(c++);
-
-	printstr2(5,0,5,"SCORE");
-	printstr2(18,0,5,"HI-SCORE");
+	puttilemap(0,0,GAME_W,GAME_H,0,SceneTitle);
 	printnumber6(5,1,7,score);
 	printnumber6(20,1,7,highscore);
 
-	printstr2(3,19,5,"LEFT   \x5c");
-	printstr2(3,20,5,"RIGHT  \x5b");
-	printstr2(3,21,5,"ROTATE \x1e");
-	printstr2(3,22,5,"DOWN   \x1f");
-	printstr2(17,19,7,"TETRIS");
-	printstr2(19,20,7,"FOR");
-	printstr2(15,21,7,"RASPBERRY PI");
-	printstr2(18,22,7,"PICO");
-	printstr2(17,23,7,"\x5eKENKEN");
-
-	printstr2(6,25,6,"PUSH START BUTTON");
+	flushtiles();
+	LCD_DisplayOn(); //起動直後はここで描画済みの画面を表示
+	if(!booted){
+		booted=1;
+		printf("boot: %u us to first frame\n",(unsigned int)to_us_since_boot(get_absolute_time()));
+	}
 	while(1){
 		gcount++;
 		if(startkeycheck(6)) return;
@@ -778,6 +747,9 @@ void game(void){
 // 2:ブロック落下中
 // 3:ステージクリア
 // 4:ゲームオーバー
+#if LCD_STATS
+	unsigned char l=0; //ライン消去前の消去ライン数
+#endif
 	gameinit2();
 	gamestatus=0;
 	while(gamestatus<4){
@@ -790,15 +762,24 @@ void game(void){
 			while(gamestatus==2){
 				wait60thsec(1);
 				sound();		//効果音出力
-				eraseblock();	//ブロック消去
 				moveblock();	//ブロック移動、着地完了チェック
-				putblock();		//ブロック配置
 				if(gamestatus==1){	//ブロック着地完了の場合
+					putblock();		//ブロックをboard配列に固定
+					setoverlay(0);
+#if LCD_STATS
+					l=lines;
+#endif
 					linecheck();//ライン完成チェック、完成ライン消去
 					if(lines>=SCENECLEARLINE) gamestatus=3;
 				}
+				else setoverlay(1); //移動した場合のみ表示を更新
 				displayscore();
-				show();			//board配列の内容を画面出力
+				show();			//board配列と落下中のブロックを画面出力
+#if LCD_STATS
+				if(gamestatus==1 && lines!=l) LCD_PrintStats("lineclear");
+				else if(gcount%60==0) LCD_PrintStats("frame");
+				lcdstats=(_LCDstats){0};
+#endif
 				gcount++;
 			}
 		}
@@ -809,23 +790,6 @@ void game(void){
 int main(void){
     stdio_init_all();
 
-	// ボタン用GPIO設定
-	gpio_init_mask(KEYSMASK);
-	gpio_set_dir_in_masked(KEYSMASK);
-	gpio_pull_up(GPIO_KEYUP);
-	gpio_pull_up(GPIO_KEYLEFT);
-	gpio_pull_up(GPIO_KEYRIGHT);
-	gpio_pull_up(GPIO_KEYDOWN);
-	gpio_pull_up(GPIO_KEYSTART);
-	gpio_pull_up(GPIO_KEYFIRE);
-
-	// サウンド用PWM設定
-	gpio_set_function(SOUNDPORT, GPIO_FUNC_PWM);
-	pwm_slice_num = pwm_gpio_to_slice_num(SOUNDPORT);
-	pwm_set_wrap(pwm_slice_num, PWM_WRAP-1);
-	// duty 50%
-	pwm_set_chan_level(pwm_slice_num, PWM_CHAN_A, PWM_WRAP/2);
-
 	// 液晶用ポート設定
     // Enable SPI 0 at 40 MHz and connect to GPIOs
     spi_init(SPICH, 40000 * 1000);
@@ -843,11 +807,33 @@ int main(void){
 	gpio_put(LCD_RESET, 1);
 	gpio_set_dir(LCD_RESET, GPIO_OUT);
 
-	init_graphic(); //液晶利用開始
-	LCD_WriteComm(0x37); //画面中央にするためスクロール設定
-	LCD_WriteData2(272);
+	init_graphic_begin(); //液晶リセット開始、リセット待ちの間に以下の初期化を行う
+	inittiles(GAME_X0,GAME_Y0); //ゲーム画面の文字単位の表示はタイルマップ経由
+
+	// ボタン用GPIO設定
+	gpio_init_mask(KEYSMASK);
+	gpio_set_dir_in_masked(KEYSMASK);
+	gpio_pull_up(GPIO_KEYUP);
+	gpio_pull_up(GPIO_KEYLEFT);
+	gpio_pull_up(GPIO_KEYRIGHT);
+	gpio_pull_up(GPIO_KEYDOWN);
+	gpio_pull_up(GPIO_KEYSTART);
+	gpio_pull_up(GPIO_KEYFIRE);
+
+	// サウンド用PWM設定
+	gpio_set_function(SOUNDPORT, GPIO_FUNC_PWM);
+	pwm_slice_num = pwm_gpio_to_slice_num(SOUNDPORT);
+	pwm_set_wrap(pwm_slice_num, PWM_WRAP-1);
+	// duty 50%
+	pwm_set_chan_level(pwm_slice_num, PWM_CHAN_A, PWM_WRAP/2);
 
 	gameinit(); //ゲーム全体初期化
+
+	init_graphic_end(); //液晶利用開始（表示はタイトル画面描画後にオン）
+#ifdef GAME_SCROLL
+	LCD_SetScroll(GAME_SCROLL%LCD_GRAMH); //画面中央にするためスクロール設定
+#endif
+
 	while(1){
 		title();//タイトル画面、スタートボタンで戻る
 		game();//ゲームメインループ
@@ -0,0 +1,106 @@
+// 当たり判定（check）のベンチマーク
+// 半分ほど埋まったランダムな盤面で、全ブロックの全方向・全列について着地するまで落下させる
+// （思考ルーチン型の配置探索）ときのcheck()の処理時間を、現在の方法（boardbits配列の各行と
+// セルのビットのAND）と以前の方法（board配列の4セルを1バイトずつ調べる）で比べる
+// 両者の判定結果が同じであることも確かめる
+
+#include <stdio.h>
+#include "hardware/spi.h"
+#define main tetris_main
+#include "../../tetrispico.c"
+#undef main
+#include "hostsim.h"
+
+#define LOOP 20000 //配置探索の回数
+
+static int check_bytes(const _Block *bp,int8_t x,int8_t y)
+{
+//以前のcheck。board配列の4セルを1バイトずつ調べる
+	if(board[y][x]) return -1;
+	if(board[y+bp->y1][x+bp->x1]) return -1;
+	if(board[y+bp->y2][x+bp->x2]) return -1;
+	if(board[y+bp->y3][x+bp->x3]) return -1;
+	return 0;
+}
+
+static volatile int sink; //最適化で探索処理が消えないよう結果を書き込む
+//ゲーム本体と同様にcheck()を関数呼び出しで計測するため、判定関数はvolatile変数経由で渡してインライン展開させない
+static int (*volatile checkfunc)(const _Block *,int8_t,int8_t);
+
+static uint64_t search(unsigned long *calls)
+{
+//checkfuncで配置探索をLOOP回行い、処理時間(ns)を返す（3回計測して最速）
+	int (*chk)(const _Block *,int8_t,int8_t);
+	const _Block *bp;
+	int r,n,a,x,y,k;
+	unsigned long c;
+	uint64_t t,best;
+	chk=checkfunc;
+	best=~0ull;
+	for(k=0;k<3;k++){
+		c=0;
+		t=hostsim_clock_ns();
+		for(r=0;r<LOOP;r++){
+			for(n=0;n<7;n++){
+				for(a=0;a<4;a++){
+					bp=&blockrot[n][a];
+					for(x=1;x<=10;x++){
+						if(x+bp->x1<1 || x+bp->x1>10 || x+bp->x2<1 || x+bp->x2>10
+							|| x+bp->x3<1 || x+bp->x3>10) continue;
+						y=3;
+						while(!chk(bp,x,y+1)) y++;
+						c+=y-2;
+						sink=y;
+					}
+				}
+			}
+		}
+		t=hostsim_clock_ns()-t;
+		if(t<best) best=t;
+	}
+	*calls=c;
+	return best;
+}
+
+int main(void)
+{
+	unsigned int s;
+	int n,a,x,y,bad;
+	unsigned long calls;
+	uint64_t t0,t1;
+	spi_init(SPICH,40000000);
+	init_graphic();
+	stopmusic();
+	gameinit2();
+
+	//下半分をランダムに埋める
+	s=3;
+	for(y=12;y<24;y++){
+		for(x=1;x<=10;x++){
+			s=s*1103515245+12345;
+			if((s>>16)%3){
+				board[y][x]=1;
+				boardbits[y]|=1<<x;
+			}
+		}
+	}
+
+	//盤面内の全ての位置で判定結果が同じこと
+	bad=0;
+	for(n=0;n<7;n++){
+		for(a=0;a<4;a++){
+			for(y=2;y<=21;y++){
+				for(x=2;x<=9;x++) bad+=check(&blockrot[n][a],x,y)!=check_bytes(&blockrot[n][a],x,y);
+			}
+		}
+	}
+	printf("positions differing: %d\n",bad);
+
+	checkfunc=check_bytes;
+	t0=search(&calls);
+	checkfunc=check;
+	t1=search(&calls);
+	printf("%lu check() calls: bytes %.2f ns/call, boardbits %.2f ns/call\n",
+		calls,(double)t0/calls,(double)t1/calls);
+	return bad!=0;
+}
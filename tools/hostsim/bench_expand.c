@@ -0,0 +1,88 @@
+// 文字画像の展開（expandglyph）のベンチマーク
+// 4ビットごとの変換表による現在の方法と、以前の方法（1ビットずつ画素色を並べてから
+// LCD_PackPixelsで送信形式に変換する）の処理速度を、文字色と背景色の組み合わせの数を変えて比べる
+// 両者の展開結果が同じであることも確かめる
+
+#include <stdio.h>
+#include <string.h>
+#include "hardware/spi.h"
+#include "../../graphlib.c"
+#include "hostsim.h"
+
+#define LOOP 2000000 //計測1回あたりの展開文字数
+
+static _Glyphword out[GLYPH_BYTES/sizeof(_Glyphword)];
+static volatile _Glyphword sink; //最適化で展開処理が消えないよう結果を書き込む
+
+static void expandglyph_perbit(_Glyphword *b,unsigned char n,unsigned short c1,unsigned short bc)
+{
+//以前の展開処理。1ビットずつ画素色を並べ、まとめて送信形式に変換する
+	int i,j,m;
+	unsigned char d;
+	unsigned short pix[FONTSIZE*FONTSIZE];
+	unsigned short *pixp;
+	pixp=pix;
+	for(i=0;i<8;i++){
+		for(j=0;j<LCD_SCALE;j++){
+			d=FontData[n*8+i];
+			for(m=0;m<8*LCD_SCALE;m++){
+				if(d&0x80) *pixp++=c1;
+				else *pixp++=bc;
+				if(m%LCD_SCALE==LCD_SCALE-1) d<<=1;
+			}
+		}
+	}
+	LCD_PackPixels((unsigned char *)b,pix,FONTSIZE*FONTSIZE);
+}
+
+static const unsigned short colors[8]={0xffff,0x1234,0xf800,0x07e0,0x001f,0xffe0,0x07ff,0xf81f};
+
+static double bench(int old,int pairs)
+{
+//文字色をpairs通りに切り替えながら展開し、1秒あたりの展開ライン数(百万)を返す（3回計測して最速）
+	int i,k;
+	uint64_t t,best;
+	best=~0ull;
+	for(k=0;k<3;k++){
+		t=hostsim_clock_ns();
+		if(old){
+			for(i=0;i<LOOP;i++){
+				expandglyph_perbit(out,i&255,colors[i%pairs],0);
+				sink=out[3];
+			}
+		}
+		else{
+			for(i=0;i<LOOP;i++){
+				expandglyph(out,i&255,colors[i%pairs],0);
+				sink=out[3];
+			}
+		}
+		t=hostsim_clock_ns()-t;
+		if(t<best) best=t;
+	}
+	return (double)LOOP*8*1000/best;
+}
+
+int main(void)
+{
+	static _Glyphword ref[GLYPH_BYTES/sizeof(_Glyphword)];
+	static const int pairs[]={1,2,8};
+	int i,k,bad;
+
+	//全文字、全ての色の組み合わせで展開結果が同じこと
+	bad=0;
+	for(k=0;k<8;k++){
+		for(i=0;i<256;i++){
+			expandglyph_perbit(ref,i,colors[k],colors[7-k]);
+			expandglyph(out,i,colors[k],colors[7-k]);
+			bad+=memcmp(ref,out,GLYPH_BYTES)!=0;
+		}
+	}
+	printf("glyphs differing: %d\n",bad);
+
+	for(k=0;k<(int)(sizeof(pairs)/sizeof(pairs[0]));k++){
+		printf("%d colour pair(s): per-bit %6.1f M rows/s, lookup table %6.1f M rows/s\n",
+			pairs[k],bench(1,pairs[k]),bench(0,pairs[k]));
+	}
+	return bad!=0;
+}
@@ -0,0 +1,153 @@
+// 塗りつぶし（boxfill、circlefill、clrbmpmn）のベンチマーク
+// 長方形16個、円24個、消去11か所を、現在の方法（長方形全体や同じ幅のラインの並びを1つのウィンドウで送信）と
+// 以前の方法（1ラインずつhlineやLCD_continuous_outputで送信）で描画し、
+// 送信量、CS/DCの切り替え回数、ウィンドウ数と表示結果を比べる
+
+#include <stdio.h>
+#include "hardware/spi.h"
+#include "../../graphlib.c"
+#include "hostsim.h"
+
+static void boxfill_rows(int x1,int y1,int x2,int y2,unsigned char c)
+{
+//以前のboxfill。1ラインずつhlineで描画
+	int temp;
+	if(x1>x2){
+		temp=x1;
+		x1=x2;
+		x2=temp;
+	}
+	if(x2<0 || x1>=X_RES) return;
+	if(y1>y2){
+		temp=y1;
+		y1=y2;
+		y2=temp;
+	}
+	if(y2<0 || y1>=Y_RES) return;
+	if(y1<0) y1=0;
+	if(y2>=Y_RES) y2=Y_RES-1;
+	while(y1<=y2){
+		hline(x1,x2,y1++,c);
+	}
+}
+
+static void circlefill_rows(int x0,int y0,unsigned int r,unsigned char c)
+{
+//以前のcirclefill。1ステップごとに4本のhlineで描画（同じラインを重ねて描くことがある）
+	int x,y,f;
+	x=r;
+	y=0;
+	f=-2*r+3;
+	while(x>=y){
+		hline(x0-x,x0+x,y0-y,c);
+		hline(x0-x,x0+x,y0+y,c);
+		hline(x0-y,x0+y,y0-x,c);
+		hline(x0-y,x0+y,y0+x,c);
+		if(f>=0){
+			x--;
+			f-=x*4;
+		}
+		y++;
+		f+=y*4+2;
+	}
+}
+
+static void clrbmpmn_rows(int x,int y,unsigned char m,unsigned char n)
+{
+//以前のclrbmpmn。1ラインずつLCD_continuous_outputで消去
+	int i,j,k;
+	if(x<=-m || x>X_RES || y<=-n || y>=Y_RES) return; //画面外
+	if(y<0) i=0; //画面上部に切れる場合
+	else i=y;
+	if(x<0) j=0; //画面左に切れる場合は残る部分のみ描画
+	else j=x;
+	if(x+m>=X_RES) k=X_RES-j; //画面右に切れる場合
+	else k=x+m-j;
+	for(;i<y+n;i++){
+		if(i>=Y_RES) return; //画面下部に切れる場合
+		LCD_continuous_output(j,i,0,k);
+	}
+}
+
+//描画する図形の種類
+enum {BOXES,DISCS,CLEARS,KIND_NUM};
+static const char *kindname[KIND_NUM]={"boxfill","circlefill","clrbmpmn"};
+
+static void shapes(int kind,int old)
+{
+//種類kindの図形を、画面からはみ出すものを含めて描画する
+	int i;
+	void (*box)(int,int,int,int,unsigned char);
+	void (*disc)(int,int,unsigned int,unsigned char);
+	void (*clr)(int,int,unsigned char,unsigned char);
+	box=old?boxfill_rows:boxfill;
+	disc=old?circlefill_rows:circlefill;
+	clr=old?clrbmpmn_rows:clrbmpmn;
+	switch(kind){
+	case BOXES:
+		for(i=0;i<15;i++) box(i*17-20,i*23-10,i*9+40,i*29-60+(i&3)*30,1+i%7);
+		box(-5,-5,300,20,3);
+		break;
+	case DISCS:
+		for(i=0;i<20;i++) disc(20+i*11,30+i*15,i*3+(i&1)*40,1+i%7);
+		disc(0,0,50,6);
+		disc(239,319,70,2);
+		disc(120,160,0,4);
+		disc(120,-200,10,4);
+		break;
+	default:
+		for(i=0;i<10;i++) clr(i*30-15,i*37-20,8+i*3,8+i*2);
+		clr(235,315,10,10);
+		break;
+	}
+}
+
+static unsigned int windows(void)
+{
+//記録した送信のうち、メモリ書き込みを開始したコマンドの数
+	int i;
+	unsigned int n;
+	n=0;
+	for(i=0;i<hostsim_loglen;i++){
+		if(hostsim_log[i].dc==0 && (hostsim_log[i].data==0x2c || hostsim_log[i].data==0x3c)) n++;
+	}
+	return n;
+}
+
+static void draw(int kind,int old)
+{
+//背景を塗りつぶしてから種類kindの図形を描画し、送信量、CS/DCの切り替え回数、ウィンドウ数を表示
+	LCD_Clear(0xffff);
+	LCD_WaitDMA();
+	hostsim_reset();
+	lcdstats=(_LCDstats){0};
+	shapes(kind,old);
+	LCD_WaitDMA();
+	printf("%-10s %s: bytes=%6u cs=%5u dc=%5u windows=%5u\n",kindname[kind],old?"rows":"rect",
+		lcdstats.bytes,lcdstats.cs,lcdstats.dc,windows());
+}
+
+static unsigned int screen[Y_RES][X_RES];
+
+int main(void)
+{
+	int k,x,y,bad,total;
+	spi_init(SPICH,40000000);
+	init_graphic();
+
+	total=0;
+	for(k=0;k<KIND_NUM;k++){
+		draw(k,1);
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) screen[y][x]=hostsim_pixel(x,y);
+		}
+		draw(k,0);
+		bad=0;
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) bad+=(screen[y][x]!=hostsim_pixel(x,y));
+		}
+		printf("%-10s pixels differing: %d\n",kindname[k],bad);
+		total+=bad;
+	}
+	return total!=0;
+}
@@ -0,0 +1,102 @@
+// 背景色なしの文字表示（putfont）のベンチマーク
+// 256文字全てを背景色なしで表示し、長方形の表FontSpanによる現在の方法と、
+// 以前の方法（各ラインの横に連続する点ごとに塗りつぶす）のウィンドウ数と送信量を比べる
+// 両者の表示結果が同じであることも確かめる
+
+#include <stdio.h>
+#include "hardware/spi.h"
+#include "../../graphlib.c"
+#include "hostsim.h"
+
+static void putfont_rowruns(int x,int y,unsigned char c,unsigned char n)
+{
+//以前の背景色なしの文字表示。横に連続する点ごとにLCD_SCALEライン分をまとめて塗りつぶす
+	int i,j,k,x1,x2,y1,y2;
+	unsigned char d;
+	const unsigned char *p;
+	unsigned short c1;
+	p=FontData+n*8;
+	c1=palette[c];
+	LCD_TxBegin();
+	for(i=0;i<8;i++){
+		y1=y+i*LCD_SCALE;
+		y2=y1+LCD_SCALE;
+		if(y1<0) y1=0;
+		if(y2>Y_RES) y2=Y_RES;
+		d=*p++;
+		if(y1>=y2 || d==0) continue;
+		k=-1; //点が連続する範囲の左端のビット位置
+		for(j=0;j<=8;j++){
+			if(j<8 && (d&0x80)){
+				if(k<0) k=j;
+			}
+			else if(k>=0){
+				x1=x+k*LCD_SCALE;
+				x2=x+j*LCD_SCALE;
+				if(x1<0) x1=0;
+				if(x2>X_RES) x2=X_RES;
+				if(x1<x2) LCD_Fill(x1,y1,x2-x1,y2-y1,c1);
+				k=-1;
+			}
+			d<<=1;
+		}
+	}
+	LCD_TxEnd();
+}
+
+static unsigned int windows(void)
+{
+//記録した送信のうち、メモリ書き込みを開始したコマンドの数
+	int i;
+	unsigned int n;
+	n=0;
+	for(i=0;i<hostsim_loglen;i++){
+		if(hostsim_log[i].dc==0 && (hostsim_log[i].data==0x2c || hostsim_log[i].data==0x3c)) n++;
+	}
+	return n;
+}
+
+static unsigned int screen[Y_RES][X_RES];
+
+static uint64_t drawall(int old)
+{
+//256文字を画面に並べて表示（16文字*16行）し、送信完了までの時間(ns)を返す
+	int n;
+	uint64_t t;
+	LCD_Clear(0);
+	LCD_WaitDMA();
+	hostsim_reset();
+	lcdstats=(_LCDstats){0};
+	t=hostsim_time_ns();
+	for(n=0;n<256;n++){
+		if(old) putfont_rowruns(n%16*FONTSIZE,n/16*FONTSIZE,7,n);
+		else putfont(n%16*FONTSIZE,n/16*FONTSIZE,7,-1,n);
+	}
+	LCD_WaitDMA();
+	return hostsim_time_ns()-t;
+}
+
+int main(void)
+{
+	int x,y,bad;
+	uint64_t t;
+	spi_init(SPICH,40000000);
+	init_graphic();
+
+	t=drawall(1);
+	printf("row runs:     windows=%u bytes=%u dc=%u SPI time %llu us\n",
+		windows(),lcdstats.bytes,lcdstats.dc,(unsigned long long)t/1000);
+	for(y=0;y<Y_RES;y++){
+		for(x=0;x<X_RES;x++) screen[y][x]=hostsim_pixel(x,y);
+	}
+
+	t=drawall(0);
+	printf("FontSpan:     windows=%u bytes=%u dc=%u SPI time %llu us\n",
+		windows(),lcdstats.bytes,lcdstats.dc,(unsigned long long)t/1000);
+	bad=0;
+	for(y=0;y<Y_RES;y++){
+		for(x=0;x<X_RES;x++) bad+=(screen[y][x]!=hostsim_pixel(x,y));
+	}
+	printf("pixels differing: %d\n",bad);
+	return bad!=0;
+}
@@ -0,0 +1,145 @@
+// グリフキャッシュ（getglyph）のベンチマーク
+// キャッシュにある文字画像を返す場合と、キャッシュにない文字を展開して登録する場合の
+// 1文字あたりの処理時間を比べる。あわせて文字で埋めた画面を2回描画したときのヒット数を数える
+// また、ゲームで表示する文字列をprintstrで描画する速度を計る。GLYPHCACHE_SIZE=0で
+// ビルドしたもの（bench_glyph_nocache）と比べると、キャッシュの有無による違いがわかる
+// graphlib.cの静的関数を呼ぶため、ソースを直接取り込む
+
+#include <stdio.h>
+#include <string.h>
+#include "hardware/spi.h"
+//printstrの計測では模擬ハードウェアの処理時間を含めないよう、graphlib.cから呼ぶ送信関数を
+//送信バイト数を数えるだけの処理に切り替えられるようにする（benchtx=0の場合は液晶ドライバを呼ぶ）
+#define LCD_TxBegin bench_txbegin
+#define LCD_TxEnd bench_txend
+#define LCD_TxWindow bench_txwindow
+#define LCD_TxQueue bench_txqueue
+#include "../../graphlib.c"
+#undef LCD_TxBegin
+#undef LCD_TxEnd
+#undef LCD_TxWindow
+#undef LCD_TxQueue
+#include "hostsim.h"
+
+void LCD_TxBegin(void);
+void LCD_TxEnd(void);
+void LCD_TxWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h);
+void LCD_TxQueue(const unsigned char *b,int n);
+
+static int benchtx; //1の場合は送信関数を呼ばずにバイト数のみ数える
+static unsigned int benchbytes; //benchtx=1の間に送信したとするバイト数
+
+void bench_txbegin(void){if(!benchtx) LCD_TxBegin();}
+void bench_txend(void){if(!benchtx) LCD_TxEnd();}
+
+void bench_txwindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+	if(!benchtx) LCD_TxWindow(x,y,w,h);
+}
+
+void bench_txqueue(const unsigned char *b,int n)
+{
+	if(benchtx) benchbytes+=n;
+	else LCD_TxQueue(b,n);
+}
+
+#define LOOP (1<<20) //256の倍数（ミスの計測で毎回同じ順に取得する）
+#define TEXT_LOOP 2000 //文字列の組を描画する回数
+
+static volatile unsigned char sink; //最適化で呼び出しが消えないよう結果を書き込む
+
+//ゲーム画面や得点表示で使う文字列
+static const char *texts[]={
+	"SCORE","HIGH SCORE","LEVEL","LINES","NEXT","GAME OVER","PUSH START BUTTON",
+	"000000","001200","012345","          "
+};
+#define TEXT_NUM (int)(sizeof(texts)/sizeof(texts[0]))
+
+static void benchtext(const char *s)
+{
+//文字列の組をprintstrでTEXT_LOOP回描画し、1文字あたりの処理時間、1文字列あたりの送信バイト数を表示
+//処理時間は送信関数を呼ばずに計る（5回計測して最速）
+	int i,j,k,chars;
+	uint64_t t,best;
+	chars=0;
+	for(j=0;j<TEXT_NUM;j++) chars+=strlen(texts[j]);
+	best=~0ull;
+	benchtx=1;
+	for(k=0;k<5;k++){
+		lcdstats=(_LCDstats){0};
+		benchbytes=0;
+		t=hostsim_clock_ns();
+		for(i=0;i<TEXT_LOOP;i++){
+			for(j=0;j<TEXT_NUM;j++) printstr(0,j*FONTSIZE,7,0,(unsigned char *)texts[j]);
+		}
+		t=hostsim_clock_ns()-t;
+		if(t<best) best=t;
+	}
+	benchtx=0;
+	printf("%s: %6.1f ns/char, %6.2f M chars/s, %u bytes/string (ghit=%u gmiss=%u)\n",s,
+		(double)best/TEXT_LOOP/chars,(double)TEXT_LOOP*chars*1000/best,
+		benchbytes/TEXT_LOOP/TEXT_NUM,lcdstats.ghit,lcdstats.gmiss);
+	//液晶ドライバで送信した場合のバイト数も同じであること
+	LCD_WaitDMA();
+	lcdstats=(_LCDstats){0};
+	for(j=0;j<TEXT_NUM;j++) printstr(0,j*FONTSIZE,7,0,(unsigned char *)texts[j]);
+	LCD_WaitDMA();
+	LCD_PrintStats("  sent through the driver, one pass");
+}
+
+#if GLYPHCACHE_SIZE>0
+static double bench(int n_glyphs,unsigned short c1,unsigned short bc)
+{
+//文字番号0からn_glyphs-1を順に取得し、1回あたりの時間(ns)を返す
+//ホストPCの負荷の影響を減らすため、5回計測して最短の時間をとる
+	int i,k;
+	uint64_t t,best;
+	best=~0ull;
+	for(k=0;k<5;k++){
+		t=hostsim_clock_ns();
+		for(i=0;i<LOOP;i++) sink=getglyph(i%n_glyphs,c1,bc)[GLYPH_BYTES-1];
+		t=hostsim_clock_ns()-t;
+		if(t<best) best=t;
+	}
+	return (double)best/LOOP;
+}
+
+static void benchcache(void)
+{
+	int i,j;
+	unsigned char s[X_RES/FONTSIZE];
+	double hit,miss;
+
+	//キャッシュに収まる文字数を繰り返す（最初の1巡以外は全てヒット）
+	lcdstats=(_LCDstats){0};
+	hit=bench(GLYPHCACHE_SETS*GLYPHCACHE_WAYS/4,palette[7],palette[0]);
+	printf("getglyph hit:  %6.1f ns/glyph (ghit=%u gmiss=%u)\n",hit,lcdstats.ghit,lcdstats.gmiss);
+	//256文字を順に取得すると各組の容量を超えるため、LRUで常にミスする
+	lcdstats=(_LCDstats){0};
+	miss=bench(256,palette[7],palette[0]);
+	printf("getglyph miss: %6.1f ns/glyph (ghit=%u gmiss=%u)\n",miss,lcdstats.ghit,lcdstats.gmiss);
+	printf("miss/hit: %.1fx\n",miss/hit);
+
+	//画面全体を文字で埋めて2回描画する（1回目は文字の種類ごとに1回ミスし、2回目は全てキャッシュから送る）
+	for(j=0;j<(int)sizeof(s);j++) s[j]='A'+j%26;
+	lcdstats=(_LCDstats){0};
+	for(i=0;i<Y_RES/FONTSIZE;i++) putfontmap(0,i*FONTSIZE,6,0,sizeof(s),1,s,sizeof(s));
+	LCD_PrintStats("text screen, 1st");
+	for(i=0;i<Y_RES/FONTSIZE;i++) putfontmap(0,i*FONTSIZE,6,0,sizeof(s),1,s,sizeof(s));
+	LCD_PrintStats("text screen, 2nd");
+}
+#endif
+
+int main(void)
+{
+	spi_init(SPICH,40000000);
+	init_graphic();
+
+#if GLYPHCACHE_SIZE>0
+	benchtext("printstr, cache on ");
+	benchcache();
+#else
+	benchtext("printstr, cache off");
+#endif
+	return 0;
+}
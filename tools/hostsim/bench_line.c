@@ -0,0 +1,159 @@
+// 線分（gline）のベンチマーク
+// 水平、垂直、緩い傾き（|dy|<|dx|/8）、45度、急な傾き（|dx|<|dy|/8）の線分を、
+// 現在の方法（連続する点を1つのウィンドウで塗りつぶす）と以前の方法（1点ずつpsetで描画）で
+// 傾きごとに描画し、1秒あたりの描画点数（40MHzのSPIでの送信完了まで）と液晶転送の統計情報、
+// 表示結果を比べる
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "hardware/spi.h"
+#include "../../graphlib.c"
+#include "hostsim.h"
+
+static void gline_pset(int x1,int y1,int x2,int y2,unsigned char c)
+{
+//以前のgline。1点ずつpsetで描画
+	int sx,sy,dx,dy,i;
+	int e;
+
+	if(x2>x1){
+		dx=x2-x1;
+		sx=1;
+	}
+	else{
+		dx=x1-x2;
+		sx=-1;
+	}
+	if(y2>y1){
+		dy=y2-y1;
+		sy=1;
+	}
+	else{
+		dy=y1-y2;
+		sy=-1;
+	}
+	if(dx>=dy){
+		e=-dx;
+		for(i=0;i<=dx;i++){
+			pset(x1,y1,c);
+			x1+=sx;
+			e+=dy*2;
+			if(e>=0){
+				y1+=sy;
+				e-=dx*2;
+			}
+		}
+	}
+	else{
+		e=-dy;
+		for(i=0;i<=dy;i++){
+			pset(x1,y1,c);
+			y1+=sy;
+			e+=dx*2;
+			if(e>=0){
+				x1+=sx;
+				e-=dy*2;
+			}
+		}
+	}
+}
+
+//線分の傾きの種類
+enum {LINE_H,LINE_V,LINE_SHALLOW,LINE_45,LINE_STEEP,CASE_NUM};
+static const char *casename[CASE_NUM]={"horizontal","vertical","shallow","45 degrees","steep"};
+#define LINES 40 //1種類あたりの線分の数
+
+static int lines(int kind,int old)
+{
+//傾きkindの線分をLINES本描画し、描画した点の数を返す
+//半数は逆向き（終点から始点へ）に描き、緩い・急な傾きと45度は右上がりと右下がりを交互にする
+	int i,x,y,dx,dy,n;
+	void (*line)(int,int,int,int,unsigned char);
+	line=old?gline_pset:gline;
+	n=0;
+	for(i=0;i<LINES;i++){
+		switch(kind){
+		case LINE_H:
+			x=10;
+			y=8+i*7;
+			dx=219;
+			dy=0;
+			break;
+		case LINE_V:
+			x=5+i*5;
+			y=10;
+			dx=0;
+			dy=299;
+			break;
+		case LINE_SHALLOW:
+			x=20;
+			y=10+i*7;
+			dx=200;
+			dy=(i&2)?24:-24;
+			if(dy<0) y+=24;
+			break;
+		case LINE_45:
+			x=10+i*3;
+			y=10+i*5;
+			dx=100;
+			dy=(i&2)?100:-100;
+			if(dy<0) y+=100;
+			break;
+		default: //LINE_STEEP
+			x=10+i*5;
+			y=10;
+			dx=(i&2)?36:-36;
+			dy=296;
+			if(dx<0) x+=36;
+			break;
+		}
+		if(i&1) line(x+dx,y+dy,x,y,1+i%7);
+		else line(x,y,x+dx,y+dy,1+i%7);
+		n+=(abs(dx)>abs(dy)?abs(dx):abs(dy))+1;
+	}
+	return n;
+}
+
+static unsigned int screen[Y_RES][X_RES];
+
+static double draw(int kind,int old)
+{
+//画面を消去して傾きkindの線分を描画し、送信完了までの時間で求めた1秒あたりの描画点数(百万)を返す
+	int n;
+	uint64_t t;
+	LCD_Clear(0);
+	LCD_WaitDMA();
+	lcdstats=(_LCDstats){0};
+	t=hostsim_time_ns();
+	n=lines(kind,old);
+	LCD_WaitDMA();
+	return n*1000.0/(hostsim_time_ns()-t);
+}
+
+int main(void)
+{
+	int k,x,y,bad,total;
+	double r;
+	spi_init(SPICH,40000000);
+	init_graphic();
+
+	total=0;
+	for(k=0;k<CASE_NUM;k++){
+		r=draw(k,1);
+		printf("%-10s pset: %5.2f M pixels/s, ",casename[k],r);
+		LCD_PrintStats("stats");
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) screen[y][x]=hostsim_pixel(x,y);
+		}
+		r=draw(k,0);
+		printf("%-10s runs: %5.2f M pixels/s, ",casename[k],r);
+		LCD_PrintStats("stats");
+		bad=0;
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) bad+=(screen[y][x]!=hostsim_pixel(x,y));
+		}
+		printf("%-10s pixels differing: %d\n",casename[k],bad);
+		total+=bad;
+	}
+	return total!=0;
+}
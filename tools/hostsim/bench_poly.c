@@ -0,0 +1,79 @@
+// 多角形の塗りつぶし（polygonfill、trianglefill）のベンチマーク
+// 液晶への送信関数を、ウィンドウ数と画素数を数えるだけの関数に置き換えて、
+// 各ラインの範囲を求めて送信するまでのCPUの処理時間を計る
+//  ・中心のまわりに回転させた16*16ドットのセル（落下中のブロックの1セル）
+//  ・画面全体に広がる三角形
+
+#include <stdio.h>
+#include <math.h>
+#include "hardware/spi.h"
+
+//graphlib.cから呼ぶ送信関数を置き換える
+#define LCD_TxBegin bench_txbegin
+#define LCD_TxEnd bench_txend
+#define LCD_TxWindow bench_txwindow
+#define LCD_TxQueue bench_txqueue
+#define LCD_Fill bench_fill
+#include "../../graphlib.c"
+#include "hostsim.h"
+
+#define CELL_NUM 1000 //回転角の異なるセルの数
+#define CELL_LOOP 200
+#define TRI_LOOP 2000
+
+static unsigned int windows; //ウィンドウ数
+static unsigned long long pixels; //塗りつぶした画素数
+
+void bench_txbegin(void){}
+void bench_txend(void){}
+void bench_txqueue(const unsigned char *b,int n){}
+
+void bench_txwindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+	windows++;
+	pixels+=w*h;
+}
+
+void bench_fill(unsigned short x,unsigned short y,unsigned short w,unsigned short h,unsigned short color)
+{
+	windows++;
+	pixels+=w*h;
+}
+
+static void result(const char *s,uint64_t t,int n)
+{
+//1回あたりの処理時間、ウィンドウ数、画素数と、画素データを40MHzのSPIで送る時間を表示
+	printf("%s: CPU %.0f ns, %.1f windows, %.0f pixels, SPI %.2f ms\n",s,(double)t/n,
+		(double)windows/n,(double)pixels/n,(double)pixels/n*LCD_PIXBYTES(1)*8/40000.0);
+}
+
+int main(void)
+{
+	static int xy[CELL_NUM][8];
+	static const int cx[4]={-8,8,8,-8},cy[4]={-8,-8,8,8};
+	int i,k,r;
+	double a;
+	uint64_t t;
+
+	for(k=0;k<CELL_NUM;k++){
+		a=k*0.05;
+		for(i=0;i<4;i++){
+			xy[k][i*2]=120+(int)lround(cx[i]*cos(a)-cy[i]*sin(a));
+			xy[k][i*2+1]=160+(int)lround(cx[i]*sin(a)+cy[i]*cos(a));
+		}
+	}
+	windows=0;
+	pixels=0;
+	t=hostsim_clock_ns();
+	for(r=0;r<CELL_LOOP;r++){
+		for(k=0;k<CELL_NUM;k++) polygonfill(4,xy[k],1);
+	}
+	result("16x16 rotated cell",hostsim_clock_ns()-t,CELL_LOOP*CELL_NUM);
+
+	windows=0;
+	pixels=0;
+	t=hostsim_clock_ns();
+	for(r=0;r<TRI_LOOP;r++) trianglefill(0,0,X_RES-1,(r*7)%Y_RES,(r*13)%X_RES,Y_RES-1,2);
+	result("full-screen triangle",hostsim_clock_ns()-t,TRI_LOOP);
+	return 0;
+}
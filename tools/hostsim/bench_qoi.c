@@ -0,0 +1,107 @@
+// QOI形式の画像表示（putqoi）のベンチマーク
+// 240*320ドットの検査用画像（qoipic.h、ビルド時にtools/mkqoi.cで変換）を表示し、
+// デコードの処理時間とSPIの送信時間、両者を重ねた場合の表示時間を比べる
+//  ・デコード：送信関数を呼ばずにputqoiを実行したホストPCでの処理時間
+//  ・SPI：デコードの時間を0として、40MHzのSPIで送信を終えるまでの時間（仮想時刻）
+//  ・重ねた場合：各ラインの送信開始前にそのラインのデコード時間だけ仮想時刻を進めて表示した時間
+//    ホストPCの速度のままと、RP2040の速度の見積もり（RP2040_SCALE倍）の2通り
+// 表示結果が元の画像と同じであることも確かめる
+
+#include <stdio.h>
+#include "hardware/spi.h"
+//graphlib.cから呼ぶ送信関数を、送信しない、またはデコード時間を仮想時刻に加えてから送信する関数に置き換える
+#define LCD_TxBegin bench_txbegin
+#define LCD_TxEnd bench_txend
+#define LCD_TxWindow bench_txwindow
+#define LCD_TxDMA bench_txdma
+#include "../../graphlib.c"
+#undef LCD_TxBegin
+#undef LCD_TxEnd
+#undef LCD_TxWindow
+#undef LCD_TxDMA
+#include "hostsim.h"
+#include "qoipic.h"
+#include "build/qoipic_240x320.c"
+
+#define IMG_W 240
+#define IMG_H 320
+#define RP2040_SCALE 30 //RP2040（125MHz）でのデコード時間がホストPCの何倍かの見積もり
+
+void LCD_TxBegin(void);
+void LCD_TxEnd(void);
+void LCD_TxWindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h);
+void LCD_TxDMA(const unsigned char *b,int n);
+
+static int benchtx; //1の場合は送信関数を呼ばない
+static uint64_t linens; //各ラインの送信前に仮想時刻を進める時間(ns)
+
+void bench_txbegin(void){if(!benchtx) LCD_TxBegin();}
+void bench_txend(void){if(!benchtx) LCD_TxEnd();}
+
+void bench_txwindow(unsigned short x,unsigned short y,unsigned short w,unsigned short h)
+{
+	if(!benchtx) LCD_TxWindow(x,y,w,h);
+}
+
+void bench_txdma(const unsigned char *b,int n)
+{
+	if(benchtx) return;
+	hostsim_wait_ns(linens); //このラインのデコード中も、前のラインのDMA転送は進む
+	LCD_TxDMA(b,n);
+}
+
+static double draw(uint64_t ns)
+{
+//1ラインのデコード時間をnsとして画像を表示し、送信完了までの時間(ms)を返す
+	uint64_t t;
+	LCD_Clear(0);
+	LCD_WaitDMA();
+	hostsim_reset();
+	linens=ns;
+	t=hostsim_time_ns();
+	putqoi(0,0,qoipic_240x320);
+	LCD_WaitDMA();
+	return (hostsim_time_ns()-t)/1e6;
+}
+
+int main(void)
+{
+	int k,x,y,bad;
+	unsigned char rgb[3];
+	uint64_t t,best;
+	double spi,dec;
+	spi_init(SPICH,40000000);
+	init_graphic();
+	printf("image %dx%d, QOI %d bytes (raw RGB565 %d bytes)\n",IMG_W,IMG_H,
+		(int)sizeof(qoipic_240x320),IMG_W*IMG_H*2);
+
+	//デコードのみの時間（5回計測して最速）
+	benchtx=1;
+	best=~0ull;
+	for(k=0;k<5;k++){
+		t=hostsim_clock_ns();
+		putqoi(0,0,qoipic_240x320);
+		t=hostsim_clock_ns()-t;
+		if(t<best) best=t;
+	}
+	benchtx=0;
+	dec=best/1e6;
+	printf("decode: %.2f ms on host (%.1f ns/pixel), about %.1f ms on RP2040 (x%d)\n",
+		dec,(double)best/(IMG_W*IMG_H),dec*RP2040_SCALE,RP2040_SCALE);
+
+	spi=draw(0);
+	printf("SPI only:              %6.2f ms\n",spi);
+	printf("overlapped, host:      %6.2f ms (sequential %.2f ms)\n",draw(best/IMG_H),spi+dec);
+	printf("overlapped, RP2040 x%d: %6.2f ms (sequential %.2f ms)\n",RP2040_SCALE,
+		draw(best*RP2040_SCALE/IMG_H),spi+dec*RP2040_SCALE);
+
+	bad=0;
+	for(y=0;y<IMG_H;y++){
+		for(x=0;x<IMG_W;x++){
+			qoipic(x,y,IMG_W,IMG_H,rgb);
+			bad+=(hostsim_pixel(x,y)!=hostsim_rgb(LCD_RGB(rgb[0],rgb[1],rgb[2])));
+		}
+	}
+	printf("pixels differing: %d\n",bad);
+	return bad!=0;
+}
@@ -0,0 +1,76 @@
+// RLE形式のスプライト表示（putrle）のベンチマーク
+// 24*24ドットのスプライトを画面内とはみ出す位置の計5か所に表示し、
+// putbmpmnと表示結果、ウィンドウ数、送信量が同じであることと、データの大きさを比べる
+// RLE形式のデータはビルド時にtools/mkrle.cでsprite24.txtから作る（build/sprite24_rle.c）
+
+#include <stdio.h>
+#include "hardware/spi.h"
+#include "../../graphlib.c"
+#include "hostsim.h"
+#include "build/sprite24_rle.c"
+
+//putbmpmn用のカラー番号の並び（0は透明）
+static const unsigned char sprite24[24*24]={
+#include "sprite24.txt"
+};
+
+static const int pos[][2]={{10,10},{-7,40},{230,100},{100,-5},{50,310}};
+#define POS_NUM (int)(sizeof(pos)/sizeof(pos[0]))
+#define BGCOLOR LCD_RGB(0x20,0x40,0x60) //透明部分が書き換えられないことを確かめるための背景色
+
+static unsigned int screen[Y_RES][X_RES];
+
+static unsigned int windows(void)
+{
+//記録した送信のうち、メモリ書き込みを開始したコマンドの数
+	int i;
+	unsigned int n;
+	n=0;
+	for(i=0;i<hostsim_loglen;i++){
+		if(hostsim_log[i].dc==0 && (hostsim_log[i].data==0x2c || hostsim_log[i].data==0x3c)) n++;
+	}
+	return n;
+}
+
+static void draw(int rle,int k,unsigned int *bytes,unsigned int *win)
+{
+//背景を塗りつぶしてからk番目の位置にスプライトを表示し、送信量とウィンドウ数を加える
+	LCD_Clear(BGCOLOR);
+	LCD_WaitDMA();
+	hostsim_reset();
+	lcdstats=(_LCDstats){0};
+	if(rle) putrle(pos[k][0],pos[k][1],sprite24_rle);
+	else putbmpmn(pos[k][0],pos[k][1],24,24,sprite24);
+	LCD_WaitDMA();
+	*bytes+=lcdstats.bytes;
+	*win+=windows();
+}
+
+int main(void)
+{
+	int k,x,y,bad;
+	unsigned int bytes[2]={0,0},win[2]={0,0};
+	spi_init(SPICH,40000000);
+	init_graphic();
+	set_palette(1,255,255,0);
+	set_palette(2,255,0,0);
+	set_palette(3,0,0,255);
+
+	bad=0;
+	for(k=0;k<POS_NUM;k++){
+		draw(0,k,&bytes[0],&win[0]);
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) screen[y][x]=hostsim_pixel(x,y);
+		}
+		draw(1,k,&bytes[1],&win[1]);
+		for(y=0;y<Y_RES;y++){
+			for(x=0;x<X_RES;x++) bad+=(screen[y][x]!=hostsim_pixel(x,y));
+		}
+	}
+	printf("putbmpmn: data %d bytes, %d positions: windows=%u bytes=%u\n",
+		(int)sizeof(sprite24),POS_NUM,win[0],bytes[0]);
+	printf("putrle:   data %d bytes, %d positions: windows=%u bytes=%u\n",
+		(int)sizeof(sprite24_rle),POS_NUM,win[1],bytes[1]);
+	printf("pixels differing: %d\n",bad);
+	return bad!=0;
+}
@@ -0,0 +1,26 @@
+// ホストPC用の模擬hardware/dma.h（tools/hostsim）
+#ifndef HOSTSIM_HARDWARE_DMA_H
+#define HOSTSIM_HARDWARE_DMA_H
+#include "hostsim.h"
+
+enum dma_channel_transfer_size { DMA_SIZE_8=0, DMA_SIZE_16=1, DMA_SIZE_32=2 };
+typedef struct {
+	enum dma_channel_transfer_size size;
+	bool read_increment,write_increment;
+	uint dreq;
+	uint ring_bits;
+	bool ring_write;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void dma_channel_configure(uint channel,const dma_channel_config *config,volatile void *write_addr,
+	const volatile void *read_addr,uint transfer_count,bool trigger);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c,enum dma_channel_transfer_size size){c->size=size;}
+static inline void channel_config_set_read_increment(dma_channel_config *c,bool incr){c->read_increment=incr;}
+static inline void channel_config_set_write_increment(dma_channel_config *c,bool incr){c->write_increment=incr;}
+static inline void channel_config_set_dreq(dma_channel_config *c,uint dreq){c->dreq=dreq;}
+static inline void channel_config_set_ring(dma_channel_config *c,bool write,uint size_bits){c->ring_write=write;c->ring_bits=size_bits;}
+#endif
@@ -0,0 +1,25 @@
+// ホストPC用の模擬hardware/gpio.h（tools/hostsim）
+#ifndef HOSTSIM_HARDWARE_GPIO_H
+#define HOSTSIM_HARDWARE_GPIO_H
+#include "hostsim.h"
+
+enum gpio_function { GPIO_FUNC_SPI=1, GPIO_FUNC_PWM=4, GPIO_FUNC_SIO=5 };
+#define GPIO_OUT 1
+#define GPIO_IN 0
+#define GPIO_IRQ_LEVEL_LOW 0x1u
+#define GPIO_IRQ_LEVEL_HIGH 0x2u
+#define GPIO_IRQ_EDGE_FALL 0x4u
+#define GPIO_IRQ_EDGE_RISE 0x8u
+typedef void (*gpio_irq_callback_t)(uint gpio,uint32_t events);
+
+void gpio_put(uint gpio,bool value);
+bool gpio_get(uint gpio);
+uint32_t gpio_get_all(void);
+void gpio_set_irq_enabled_with_callback(uint gpio,uint32_t events,bool enabled,gpio_irq_callback_t callback);
+static inline void gpio_init(uint gpio){(void)gpio;}
+static inline void gpio_init_mask(uint32_t mask){(void)mask;}
+static inline void gpio_set_dir(uint gpio,bool out){(void)gpio;(void)out;}
+static inline void gpio_set_dir_in_masked(uint32_t mask){(void)mask;}
+static inline void gpio_set_function(uint gpio,enum gpio_function f){(void)gpio;(void)f;}
+static inline void gpio_pull_up(uint gpio){(void)gpio;}
+#endif
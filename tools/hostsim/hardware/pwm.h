@@ -0,0 +1,14 @@
+// ホストPC用の模擬hardware/pwm.h（tools/hostsim）
+// 音は出さないので何もしない
+#ifndef HOSTSIM_HARDWARE_PWM_H
+#define HOSTSIM_HARDWARE_PWM_H
+#include "hostsim.h"
+
+#define PWM_CHAN_A 0
+#define PWM_CHAN_B 1
+static inline uint pwm_gpio_to_slice_num(uint gpio){return (gpio>>1)&7;}
+static inline void pwm_set_clkdiv_int_frac(uint slice,uint8_t integer,uint8_t fract){(void)slice;(void)integer;(void)fract;}
+static inline void pwm_set_wrap(uint slice,uint16_t wrap){(void)slice;(void)wrap;}
+static inline void pwm_set_chan_level(uint slice,uint chan,uint16_t level){(void)slice;(void)chan;(void)level;}
+static inline void pwm_set_enabled(uint slice,bool enabled){(void)slice;(void)enabled;}
+#endif
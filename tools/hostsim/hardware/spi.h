@@ -0,0 +1,24 @@
+// ホストPC用の模擬hardware/spi.h（tools/hostsim）
+#ifndef HOSTSIM_HARDWARE_SPI_H
+#define HOSTSIM_HARDWARE_SPI_H
+#include "hostsim.h"
+
+typedef struct {
+	volatile uint32_t cr0,cr1,dr,sr,cpsr,imsc,ris,mis,icr,dmacr;
+} spi_hw_t;
+typedef struct spi_inst spi_inst_t;
+extern spi_hw_t hostsim_spi_hw;
+#define spi0 ((spi_inst_t *)&hostsim_spi_hw)
+#define SPI_SSPICR_RORIC_BITS 0x1u
+typedef enum { SPI_CPOL_0=0, SPI_CPOL_1=1 } spi_cpol_t;
+typedef enum { SPI_CPHA_0=0, SPI_CPHA_1=1 } spi_cpha_t;
+typedef enum { SPI_LSB_FIRST=0, SPI_MSB_FIRST=1 } spi_order_t;
+
+uint spi_init(spi_inst_t *spi,uint baudrate);
+void spi_set_format(spi_inst_t *spi,uint data_bits,spi_cpol_t cpol,spi_cpha_t cpha,spi_order_t order);
+int spi_write_blocking(spi_inst_t *spi,const uint8_t *src,size_t len);
+static inline spi_hw_t *spi_get_hw(spi_inst_t *spi){(void)spi;return &hostsim_spi_hw;}
+static inline bool spi_is_busy(const spi_inst_t *spi){(void)spi;return false;}
+static inline bool spi_is_readable(const spi_inst_t *spi){(void)spi;return false;}
+static inline uint spi_get_dreq(spi_inst_t *spi,bool is_tx){(void)spi;return is_tx?16:17;}
+#endif
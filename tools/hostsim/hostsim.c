@@ -0,0 +1,456 @@
+// ホストPC用の模擬ハードウェア（tools/hostsim）
+// 使い方はhostsim.hとMakefileを参照
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "LCDdriver.h"
+
+#define HOSTSIM_POLL_NS 500 //時刻を読むごとに進める時間（待ちループ1回分）
+#define HOSTSIM_GRAMW 480 //模擬する液晶のメモリの大きさ（列アドレスと行アドレスの最大値+1）
+#define HOSTSIM_GRAMH 480
+
+_Hostlog *hostsim_log;
+int hostsim_loglen;
+int hostsim_errors;
+int hostsim_fails;
+unsigned int hostsim_csfalls;
+unsigned long long hostsim_cpubits;
+unsigned long long hostsim_dmabits;
+unsigned int hostsim_tears;
+uint32_t hostsim_keys=0xffffffff;
+spi_hw_t hostsim_spi_hw;
+
+static int logsize; //hostsim_logの確保済みの要素数
+static uint64_t now; //仮想時刻(ns)
+static unsigned int bitns=25; //SPIの1ビットの時間(ns)
+static unsigned int spibits=8; //SPIのフレームのビット数
+static unsigned char cs=1,dc=1; //CSとDCの出力
+static unsigned int csno; //CSアサートの通し番号
+
+//液晶コントローラ
+static unsigned int gram[HOSTSIM_GRAMH][HOSTSIM_GRAMW]; //メモリの内容（0xRRGGBB）
+static int command=-1; //実行中のコマンド
+static unsigned char param[4]; //コマンドのパラメータ
+static int nparam; //受信したパラメータのバイト数
+static unsigned int acc; //受信途中のビット
+static int accbits; //accに溜まっているビット数
+static int pixbits=16; //1画素のビット数（COLMODで設定）
+static int xs,xe,ys,ye; //アドレスウィンドウ
+static int wx,wy; //メモリ書き込み位置
+static unsigned char madctl; //Memory Access Control
+static int scroll; //縦スクロール位置
+static unsigned char dispon; //表示オン
+
+//走査とTE出力
+static uint64_t teperiod=LCD_FRAME_US*1000ull; //走査の周期(ns)
+static uint64_t tephase; //走査開始の時刻(ns)
+static unsigned char teset; //hostsim_te()で設定済み
+static int tepin=-1; //TE出力の割り込みを設定したGPIO
+static gpio_irq_callback_t tecallback;
+static unsigned char inirq; //割り込み処理中
+
+//DMA
+static struct {
+	dma_channel_config config;
+	const unsigned char *read; //読み出し開始アドレス
+	uint count; //転送回数
+	uint64_t start; //転送開始時刻
+	unsigned char pending; //未処理の転送がある
+} dma;
+
+static void error(const char *s)
+{
+	fprintf(stderr,"hostsim: %s\n",s);
+	hostsim_errors++;
+}
+
+static int scanline(uint64_t t)
+{
+//時刻tに走査中の表示上のライン
+	return (t+teperiod-tephase%teperiod)%teperiod*LCD_GRAMH/teperiod;
+}
+
+static void advance(uint64_t ns)
+{
+//仮想時刻をnsだけ進める。途中で走査開始の時刻を過ぎる場合はTE出力の割り込みを呼び出す
+	uint64_t t,edge;
+	t=now+ns;
+	if(tecallback && !inirq){
+		while(1){
+			edge=now+(teperiod-(now+teperiod-tephase%teperiod)%teperiod); //次の走査開始の時刻
+			if(edge>t) break;
+			now=edge;
+			inirq=1;
+			tecallback(tepin,GPIO_IRQ_EDGE_RISE);
+			inirq=0;
+		}
+	}
+	if(t>now) now=t;
+}
+
+static void putpixel(unsigned int rgb,uint64_t t)
+{
+//メモリ書き込み位置に1画素書き込み、書き込み位置を進める
+	int row;
+	if(wy<HOSTSIM_GRAMH && wx<HOSTSIM_GRAMW) gram[wy][wx]=rgb;
+	if(dispon){
+		//行列交換(MV)の場合は列アドレスがパネルの走査ラインになる
+		row=(madctl&0x20)?wx:wy;
+		if((row+LCD_GRAMH-scroll)%LCD_GRAMH==scanline(t)) hostsim_tears++;
+	}
+	if(++wx>xe){
+		wx=xs;
+		if(++wy>ye) wy=ys;
+	}
+}
+
+static void lcdframe(unsigned int v,int bits,uint64_t t)
+{
+//液晶コントローラが1フレームを受信
+	unsigned int b;
+	if(!dc){
+		command=v&0xff;
+		nparam=0;
+		accbits=0;
+		if(command==0x2c){
+			wx=xs;
+			wy=ys;
+		}
+		else if(command==0x29) dispon=1;
+		else if(command==0x28) dispon=0;
+		if(command==0x29 && !teset) tephase=t;
+		return;
+	}
+	acc=(acc<<bits)|(v&((1u<<bits)-1));
+	accbits+=bits;
+	if(command==0x2c || command==0x3c){
+		while(accbits>=pixbits){
+			accbits-=pixbits;
+			b=(acc>>accbits)&((1u<<pixbits)-1);
+			if(pixbits==16) putpixel(((b>>11)<<19)|(((b>>5)&63)<<10)|((b&31)<<3),t);
+			else if(pixbits==12) putpixel(((b>>8)<<20)|(((b>>4)&15)<<12)|((b&15)<<4),t);
+			else putpixel(b&0xfcfcfc,t);
+		}
+		return;
+	}
+	while(accbits>=8){
+		accbits-=8;
+		b=(acc>>accbits)&0xff;
+		if(nparam<4) param[nparam]=b;
+		nparam++;
+		if(command==0x2a && nparam==4){
+			xs=(param[0]<<8)|param[1];
+			xe=(param[2]<<8)|param[3];
+		}
+		else if(command==0x2b && nparam==4){
+			ys=(param[0]<<8)|param[1];
+			ye=(param[2]<<8)|param[3];
+		}
+		else if(command==0x3a && nparam==1) pixbits=((b&7)==3)?12:((b&7)==6)?24:16;
+		else if(command==0x36 && nparam==1) madctl=b;
+		else if(command==0x37 && nparam==2) scroll=(param[0]<<8)|param[1];
+	}
+}
+
+static void spiframe(unsigned int v,int isdma,uint64_t t)
+{
+//SPIで1フレーム送信
+	if(cs) error("data sent while CS is high");
+	if(hostsim_loglen==logsize){
+		logsize=logsize?logsize*2:65536;
+		hostsim_log=realloc(hostsim_log,logsize*sizeof(_Hostlog));
+	}
+	hostsim_log[hostsim_loglen++]=(_Hostlog){v,spibits,dc,isdma,csno};
+	if(isdma) hostsim_dmabits+=spibits;
+	else hostsim_cpubits+=spibits;
+	lcdframe(v,spibits,t);
+}
+
+static void dmarun(void)
+{
+//未処理のDMA転送の内容を送信した扱いにする
+//転送は終了時刻にまとめて処理するので、転送中にバッファを書き換えると送信内容が変わり検出できる
+	uint i;
+	uintptr_t a,mask;
+	unsigned int v,size,frame;
+	if(!dma.pending) return;
+	dma.pending=0;
+	size=1<<dma.config.size;
+	frame=spibits*bitns;
+	mask=dma.config.ring_bits?(1u<<dma.config.ring_bits)-1:~(uintptr_t)0;
+	for(i=0;i<dma.count;i++){
+		a=(uintptr_t)dma.read;
+		if(dma.config.read_increment) a=(a&~mask)|((a+i*size)&mask);
+		if(size==1) v=*(const uint8_t *)a;
+		else if(size==2) v=*(const uint16_t *)a;
+		else v=*(const uint32_t *)a;
+		spiframe(v,1,dma.start+(uint64_t)i*frame);
+	}
+}
+
+static uint64_t dmaend(void)
+{
+	return dma.start+(uint64_t)dma.count*spibits*bitns;
+}
+
+static void dmacheck(const char *s)
+{
+//DMA転送中に行ってはいけない操作の前に呼ぶ
+	if(!dma.pending) return;
+	if(now<dmaend()) error(s);
+	dmarun();
+}
+
+static void dmafinish(void)
+{
+//DMA転送の終了時刻まで進めて転送を完了させる
+	if(!dma.pending) return;
+	if(now<dmaend()) advance(dmaend()-now);
+	dmarun();
+}
+
+void hostsim_reset(void)
+{
+	hostsim_loglen=0;
+	hostsim_errors=0;
+	hostsim_csfalls=0;
+	hostsim_cpubits=0;
+	hostsim_dmabits=0;
+	hostsim_tears=0;
+}
+
+int hostsim_cs(void)
+{
+	return cs;
+}
+
+int hostsim_dmabusy(void)
+{
+	return dma.pending && now<dmaend();
+}
+
+uint64_t hostsim_time_ns(void)
+{
+	return now;
+}
+
+void hostsim_wait_ns(uint64_t ns)
+{
+	advance(ns);
+}
+
+unsigned int hostsim_pixel(int x,int y)
+{
+	//テストからの読み出しは、送信済みのデータが液晶に届いた後の内容を返す
+	dmafinish();
+	return gram[y][x];
+}
+
+unsigned int hostsim_rgb(unsigned short color)
+{
+#if LCD_COLORMODE == LCD_COLOR12
+	return ((color>>8)<<20)|(((color>>4)&15)<<12)|((color&15)<<4);
+#else
+	//RGB565、18ビットの場合も各色の下位ビットは0になる
+	return ((color>>11)<<19)|(((color>>5)&63)<<10)|((color&31)<<3);
+#endif
+}
+
+void hostsim_te(unsigned int period_us,unsigned int phase_us)
+{
+	teperiod=period_us*1000ull;
+	tephase=phase_us*1000ull;
+	teset=1;
+}
+
+int hostsim_scanline(void)
+{
+	return scanline(now);
+}
+
+void hostsim_dump(const char *fn,int w,int h)
+{
+	FILE *fp;
+	int x,y;
+	dmafinish();
+	fp=fopen(fn,"wb");
+	if(fp==NULL) return;
+	fprintf(fp,"P6\n%d %d\n255\n",w,h);
+	for(y=0;y<h;y++){
+		for(x=0;x<w;x++){
+			fputc(gram[y][x]>>16,fp);
+			fputc(gram[y][x]>>8,fp);
+			fputc(gram[y][x],fp);
+		}
+	}
+	fclose(fp);
+}
+
+uint64_t hostsim_clock_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec*1000000000ull+ts.tv_nsec;
+}
+
+// 時刻
+absolute_time_t get_absolute_time(void)
+{
+	advance(HOSTSIM_POLL_NS);
+	return now/1000;
+}
+
+uint32_t time_us_32(void)
+{
+	advance(HOSTSIM_POLL_NS);
+	return (uint32_t)(now/1000);
+}
+
+uint64_t time_us_64(void)
+{
+	advance(HOSTSIM_POLL_NS);
+	return now/1000;
+}
+
+void sleep_ms(uint32_t ms)
+{
+	advance(ms*1000000ull);
+}
+
+void sleep_us(uint64_t us)
+{
+	advance(us*1000);
+}
+
+void busy_wait_us(uint64_t us)
+{
+	advance(us*1000);
+}
+
+void sleep_until(absolute_time_t t)
+{
+	if(t*1000>now) advance(t*1000-now);
+}
+
+bool stdio_init_all(void)
+{
+	return true;
+}
+
+// GPIO
+void gpio_put(uint gpio,bool value)
+{
+	if(gpio==LCD_CS){
+		if(value!=cs) dmacheck("CS changed while DMA busy");
+		if(!value && cs){
+			hostsim_csfalls++;
+			csno++;
+		}
+		//CSを解放すると受信途中のビットは捨てられる
+		if(value) accbits=0;
+		cs=value;
+	}
+	else if(gpio==LCD_DC){
+		if(value!=dc) dmacheck("DC changed while DMA busy");
+		dc=value;
+	}
+}
+
+bool gpio_get(uint gpio)
+{
+	if((int)gpio==tepin) return scanline(now)==0;
+	return (hostsim_keys>>gpio)&1;
+}
+
+uint32_t gpio_get_all(void)
+{
+	return hostsim_keys;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio,uint32_t events,bool enabled,gpio_irq_callback_t callback)
+{
+	(void)events;
+	tepin=gpio;
+	tecallback=enabled?callback:NULL;
+}
+
+// SPI
+uint spi_init(spi_inst_t *spi,uint baudrate)
+{
+	(void)spi;
+	bitns=1000000000u/baudrate;
+	return baudrate;
+}
+
+void spi_set_format(spi_inst_t *spi,uint data_bits,spi_cpol_t cpol,spi_cpha_t cpha,spi_order_t order)
+{
+	(void)spi;
+	(void)cpol;
+	(void)cpha;
+	(void)order;
+	dmacheck("SPI format changed while DMA busy");
+	spibits=data_bits;
+}
+
+int spi_write_blocking(spi_inst_t *spi,const uint8_t *src,size_t len)
+{
+	size_t i;
+	(void)spi;
+	dmacheck("SPI written while DMA busy");
+	for(i=0;i<len;i++){
+		advance(spibits*bitns);
+		spiframe(src[i],0,now);
+	}
+	return len;
+}
+
+// DMA
+int dma_claim_unused_channel(bool required)
+{
+	(void)required;
+	return 0;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+	dma_channel_config c;
+	(void)channel;
+	memset(&c,0,sizeof(c));
+	c.size=DMA_SIZE_32;
+	c.read_increment=true;
+	return c;
+}
+
+void dma_channel_configure(uint channel,const dma_channel_config *config,volatile void *write_addr,
+	const volatile void *read_addr,uint transfer_count,bool trigger)
+{
+	(void)channel;
+	if(write_addr!=&hostsim_spi_hw.dr) error("DMA destination is not the SPI data register");
+	if(!trigger) return;
+	dmacheck("DMA started while DMA busy");
+	dma.config=*config;
+	dma.read=(const unsigned char *)read_addr;
+	dma.count=transfer_count;
+	dma.start=now;
+	dma.pending=1;
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+	(void)channel;
+	advance(HOSTSIM_POLL_NS);
+	if(hostsim_dmabusy()) return true;
+	dmarun();
+	return false;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+	(void)channel;
+	dmafinish();
+}
@@ -0,0 +1,79 @@
+// ホストPC用の模擬ハードウェア（tools/hostsim）
+// pico-sdkのGPIO、SPI、DMA、時刻の関数を置き換えて、液晶ドライバとgraphlibをホストPCで動かす
+// 液晶に送られたCS/DC/データの並びを記録し、液晶コントローラの動作（アドレスウィンドウ、
+// メモリ書き込み、縦スクロール、走査線とTE出力）を模擬する
+// 時刻はSPIの送信やDMA転送の時間、待ち関数の呼び出しで進む仮想時刻
+
+#ifndef HOSTSIM_H
+#define HOSTSIM_H
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+//記録した1フレーム分の送信
+typedef struct {
+	unsigned short data; //送信した値（8ビットまたは12ビット）
+	unsigned char bits; //フレームのビット数
+	unsigned char dc; //DC出力（0:コマンド、1:データ）
+	unsigned char dma; //DMAで送信した場合は1
+	unsigned int cs; //何回目のCSアサート中に送信したか（1から）
+} _Hostlog;
+
+extern _Hostlog *hostsim_log; //送信の記録
+extern int hostsim_loglen; //記録したフレーム数
+extern int hostsim_errors; //検出した誤った操作の数（DMA転送中のCS/DC変更、CS解放中の送信など）
+extern unsigned int hostsim_csfalls; //CSアサート回数
+extern unsigned long long hostsim_cpubits; //CPUがブロッキング送信したビット数
+extern unsigned long long hostsim_dmabits; //DMAで送信したビット数
+extern unsigned int hostsim_tears; //表示中に走査線上の画素へ書き込んだ回数
+extern uint32_t hostsim_keys; //gpio_get_all()が返す値
+
+void hostsim_reset(void);
+//送信の記録とカウンタをクリア（液晶の画像と時刻はそのまま）
+
+int hostsim_cs(void);
+//現在のCS出力
+
+int hostsim_dmabusy(void);
+//現在の時刻でDMA転送が終わっていなければ1
+
+uint64_t hostsim_time_ns(void);
+//現在の仮想時刻(ns)
+
+void hostsim_wait_ns(uint64_t ns);
+//仮想時刻をnsだけ進める（CPUが別の処理をしている時間）
+
+unsigned int hostsim_pixel(int x,int y);
+//液晶のメモリの(x,y)の色を0xRRGGBBで返す（DMA転送中の場合は転送の終了時刻まで進めてから読む）
+
+unsigned int hostsim_rgb(unsigned short color);
+//ドライバの画素色colorが液晶に表示される色を0xRRGGBBで返す
+
+void hostsim_te(unsigned int period_us,unsigned int phase_us);
+//走査の周期と、走査開始（TE出力の立ち上がり）の時刻の位相を設定
+//設定しない場合は、周期はLCD_FRAME_US、位相は表示オンの時刻
+
+int hostsim_scanline(void);
+//現在走査中の表示上のライン
+
+void hostsim_dump(const char *fn,int w,int h);
+//液晶のメモリの左上w*hドットをPPM形式で書き出す
+
+uint64_t hostsim_clock_ns(void);
+//ホストPCの実時間(ns)。ベンチマークでの処理時間の計測用（仮想時刻とは無関係）
+
+
+//テスト用の検査。条件cが成り立たない場合は失敗として表示し、hostsim_failsを増やす
+extern int hostsim_fails;
+#define HOSTSIM_CHECK(c,...) do{ \
+	if(!(c)){ \
+		printf("%s:%d: FAIL: ",__FILE__,__LINE__); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+		hostsim_fails++; \
+	} \
+}while(0)
+
+#endif
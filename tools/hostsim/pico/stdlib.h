@@ -0,0 +1,28 @@
+// ホストPC用の模擬pico/stdlib.h（tools/hostsim）
+#ifndef HOSTSIM_PICO_STDLIB_H
+#define HOSTSIM_PICO_STDLIB_H
+#include <stdio.h>
+#include "hostsim.h"
+#include "hardware/gpio.h"
+
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time(void);
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+void sleep_until(absolute_time_t t);
+void busy_wait_us(uint64_t us);
+bool stdio_init_all(void);
+
+static inline uint64_t to_us_since_boot(absolute_time_t t){return t;}
+static inline absolute_time_t make_timeout_time_us(uint64_t us){return get_absolute_time()+us;}
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms){return get_absolute_time()+ms*1000ull;}
+static inline int64_t absolute_time_diff_us(absolute_time_t from,absolute_time_t to){return (int64_t)(to-from);}
+static inline void tight_loop_contents(void){}
+
+#define PICO_DEFAULT_SPI_RX_PIN 16
+#define PICO_DEFAULT_SPI_SCK_PIN 18
+#define PICO_DEFAULT_SPI_TX_PIN 19
+#endif
@@ -0,0 +1,31 @@
+// QOI形式の検査用画像（qoipic.h）をバイナリ形式のPPM画像（P6）で標準出力に書き出す
+// tools/mkqoi.cの入力に使う
+//   ./qoipic w h > image.ppm
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "qoipic.h"
+
+int main(int argc,char *argv[]){
+	int w,h,x,y;
+	unsigned char rgb[3];
+	if(argc<3){
+		fprintf(stderr,"usage: qoipic width height > out.ppm\n");
+		return 1;
+	}
+	w=atoi(argv[1]);
+	h=atoi(argv[2]);
+	if(w<1 || h<6){
+		fprintf(stderr,"width must be 1 or more, height 6 or more\n");
+		return 1;
+	}
+	printf("P6\n%d %d\n255\n",w,h);
+	for(y=0;y<h;y++){
+		for(x=0;x<w;x++){
+			qoipic(x,y,w,h,rgb);
+			fwrite(rgb,1,3,stdout);
+		}
+	}
+	return 0;
+}
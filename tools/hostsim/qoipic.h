@@ -0,0 +1,52 @@
+// QOI形式の検査用画像（test_qoi、bench_qoi、qoipic.c）
+// tools/mkqoi.cで変換したときにQOI_OP_RGB、INDEX、DIFF、LUMA、RUNの全てが現れるよう、
+// 画像を縦に6つの帯に分け、帯ごとに以下の絵柄にする
+//  0:単色（行の境界をまたぐ並び、62画素を超える並び）
+//  1:直前の画素との差が小さい（DIFF）
+//  2:一定の傾きのグラデーション（LUMA）
+//  3:4色の繰り返し（INDEX）
+//  4:ノイズ（RGB）
+//  5:画像全体の画素の並びで16画素ごとに色を変えた縞（行の境界をまたぐ並び）
+
+#include <string.h>
+
+static void qoipic(int x,int y,int w,int h,unsigned char *rgb)
+{
+//横w*縦hの画像の(x,y)の色をrgb[0]〜rgb[2]（赤、緑、青）に書き込む
+	static const unsigned char pal[4][3]={{255,0,0},{0,255,0},{0,0,255},{255,255,0}};
+	unsigned int k;
+	switch(y*6/h){
+	case 0:
+		rgb[0]=40;
+		rgb[1]=80;
+		rgb[2]=160;
+		break;
+	case 1:
+		rgb[0]=100+x%3;
+		rgb[1]=60+x/3;
+		rgb[2]=200+(x+y)%2;
+		break;
+	case 2:
+		rgb[0]=x*7+y;
+		rgb[1]=x*5+y*2;
+		rgb[2]=x*3;
+		break;
+	case 3:
+		memcpy(rgb,pal[(x+y)%4],3);
+		break;
+	case 4:
+		k=(x*1103515245u+y*12345u)^(x*y*2654435761u);
+		k^=k>>13;
+		k*=0x5bd1e995u;
+		rgb[0]=k>>24;
+		rgb[1]=k>>16;
+		rgb[2]=k>>8;
+		break;
+	default:
+		k=(y*w+x)/16;
+		rgb[0]=k*37;
+		rgb[1]=k*91;
+		rgb[2]=255-k*13;
+		break;
+	}
+}
@@ -0,0 +1,136 @@
+// DMAによる塗りつぶし（LCD_Clear、LCD_Fill、LCD_continuous_output）の送信内容を検査する
+// CS/DC/データの並びが、ウィンドウ設定に続けて同じ色を画素数分送るものになっていること、
+// DMA転送中はすぐに戻り、CPUがほとんど待たされないことを確かめる
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "LCDdriver.h"
+#include "hostsim.h"
+
+#define SPI_BAUD 40000000
+
+static int commandindex(int from,unsigned char comm)
+{
+//記録のfrom番目以降で最初にcommを送った位置、なければ-1
+	int i;
+	for(i=from;i<hostsim_loglen;i++){
+		if(hostsim_log[i].dc==0 && hostsim_log[i].data==comm) return i;
+	}
+	return -1;
+}
+
+static unsigned int param2(int i)
+{
+//記録のi番目から2バイトのパラメータ
+	return (hostsim_log[i].data<<8)|hostsim_log[i+1].data;
+}
+
+static void checkrect(int x,int y,int w,int h,unsigned short color,const char *s)
+{
+//(x,y)から横w*縦hの範囲がcolorで、その周囲1ドットは変わっていないこと
+	int i,j,bad;
+	unsigned int c,around;
+	around=hostsim_rgb(0);
+	bad=0;
+	for(i=y-1;i<=y+h;i++){
+		for(j=x-1;j<=x+w;j++){
+			if(i<0 || i>=Y_RES || j<0 || j>=X_RES) continue;
+			c=hostsim_pixel(j,i);
+			if(i>=y && i<y+h && j>=x && j<x+w) bad+=(c!=hostsim_rgb(color));
+			else bad+=(c!=around);
+		}
+	}
+	HOSTSIM_CHECK(bad==0,"%s: %d pixels differ",s,bad);
+}
+
+static void testclear(void)
+{
+	unsigned short color;
+	uint64_t t,tx;
+	int i,k;
+	unsigned long long bits;
+
+	color=LCD_RGB(0x12,0x34,0x56);
+	hostsim_reset();
+	t=hostsim_time_ns();
+	LCD_Clear(color);
+	t=hostsim_time_ns()-t;
+	//DMA転送を開始してすぐに戻り、CSは転送完了までアサートしたまま
+	HOSTSIM_CHECK(hostsim_dmabusy(),"LCD_Clear waited for the transfer");
+	HOSTSIM_CHECK(hostsim_cs()==0,"CS released during the transfer");
+	tx=(unsigned long long)LCD_PIXBYTES(X_RES*Y_RES)*8*1000000000/SPI_BAUD;
+#if LCD_COLORMODE == LCD_COLOR18
+	//18ビットはパターンの繰り返し送信で、最後の1回分のみ待たずに戻る
+	HOSTSIM_CHECK(t<tx,"LCD_Clear blocked for %llu us of a %llu us transfer",
+		(unsigned long long)t/1000,(unsigned long long)tx/1000);
+#else
+	HOSTSIM_CHECK(t*20<tx,"LCD_Clear blocked for %llu us of a %llu us transfer",
+		(unsigned long long)t/1000,(unsigned long long)tx/1000);
+#endif
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_cs()==1,"CS not released after LCD_WaitDMA");
+	HOSTSIM_CHECK(hostsim_errors==0,"%d protocol errors",hostsim_errors);
+	HOSTSIM_CHECK(hostsim_csfalls==1,"%u CS assertions",hostsim_csfalls);
+
+	//CASET、PASET、RAMWRの後に画素データのみが続く
+	i=commandindex(0,0x2a);
+	HOSTSIM_CHECK(i==0,"CASET is not the first frame");
+	HOSTSIM_CHECK(i>=0 && param2(i+1)==0 && param2(i+3)==X_RES-1,"bad CASET");
+	i=commandindex(0,0x2b);
+	HOSTSIM_CHECK(i==5,"PASET does not follow CASET");
+	HOSTSIM_CHECK(i>=0 && param2(i+1)==0 && param2(i+3)==Y_RES-1,"bad PASET");
+	k=commandindex(0,0x2c);
+	HOSTSIM_CHECK(k==10,"RAMWR does not follow PASET");
+	bits=0;
+	for(i=k+1;i<hostsim_loglen;i++){
+		if(hostsim_log[i].dc==0) break;
+		bits+=hostsim_log[i].bits;
+	}
+	HOSTSIM_CHECK(i==hostsim_loglen,"command after the pixel data");
+	HOSTSIM_CHECK(bits==(unsigned long long)LCD_PIXBYTES(X_RES*Y_RES)*8,"%llu pixel bits sent",bits);
+	HOSTSIM_CHECK(hostsim_cpubits<=11*8,"%llu bits sent by the CPU",hostsim_cpubits);
+	checkrect(0,0,X_RES,Y_RES,color,"LCD_Clear");
+	printf("LCD_Clear: CPU %llu us, transfer %llu us\n",(unsigned long long)t/1000,(unsigned long long)tx/1000);
+}
+
+static void testfill(void)
+{
+	unsigned short color;
+	static const unsigned short rect[][4]={{0,0,1,1},{10,20,1,30},{5,7,33,1},{100,150,17,9},{X_RES-3,Y_RES-2,3,2}};
+	int k;
+	char s[64];
+
+	for(k=0;k<(int)(sizeof(rect)/sizeof(rect[0]));k++){
+		LCD_Clear(0);
+		LCD_WaitDMA();
+		color=LCD_RGB(0xff,0x80+k*16,0x40);
+		hostsim_reset();
+		LCD_Fill(rect[k][0],rect[k][1],rect[k][2],rect[k][3],color);
+		LCD_WaitDMA();
+		HOSTSIM_CHECK(hostsim_errors==0,"%d protocol errors",hostsim_errors);
+		HOSTSIM_CHECK(hostsim_csfalls==1,"%u CS assertions",hostsim_csfalls);
+		sprintf(s,"LCD_Fill %d,%d %dx%d",rect[k][0],rect[k][1],rect[k][2],rect[k][3]);
+		checkrect(rect[k][0],rect[k][1],rect[k][2],rect[k][3],color,s);
+	}
+
+	LCD_Clear(0);
+	LCD_WaitDMA();
+	color=LCD_RGB(0x20,0xff,0x20);
+	hostsim_reset();
+	LCD_continuous_output(30,40,color,50);
+	LCD_continuous_output(30,41,color,0);
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_errors==0,"%d protocol errors",hostsim_errors);
+	checkrect(30,40,50,1,color,"LCD_continuous_output");
+}
+
+int main(void)
+{
+	spi_init(SPICH,SPI_BAUD);
+	LCD_Init();
+	testclear();
+	testfill();
+	printf("test_fill: %s\n",hostsim_fails?"FAILED":"ok");
+	return hostsim_fails!=0;
+}
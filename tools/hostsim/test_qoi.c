@@ -0,0 +1,196 @@
+// QOI形式の画像表示（putqoi）を検査する
+// 奇数・偶数の横幅と縦幅の画像を、そのままとクリッピングした状態で表示し、
+// 全画素が元の画像の色になり、範囲外は書き換えられないことを確かめる
+// 12ビットカラーで2画素を3バイトに詰める際の、ライン間の画素の持ち越しの検査を兼ねる
+// 画像は以下の2種類
+//  ・QOI_OP_RGBとQOI_OP_RGBAを交互に並べてここで作るもの
+//  ・検査用画像（qoipic.h）をビルド時にtools/mkqoi.cで変換したもの（build/qoipic_*.c）
+//    INDEX、DIFF、LUMA、RUN（行の境界をまたぐものを含む）が全て現れることも確かめる
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "LCDdriver.h"
+#include "graphlib.h"
+#include "hostsim.h"
+#include "qoipic.h"
+#include "build/qoipic_40x24.c"
+#include "build/qoipic_37x23.c"
+
+#define IMG_MAX 16
+#define BGCOLOR LCD_RGB(0x10,0x20,0x30)
+
+static unsigned char qoi[14+IMG_MAX*IMG_MAX*5+8];
+static const unsigned char *img; //検査する画像
+static int imgw,imgh; //画像の横幅、縦幅
+static void (*imgrgb)(int x,int y,unsigned char *rgb); //画像の(x,y)の元の色
+
+static unsigned char red(int x,int y){return 20+x*13;}
+static unsigned char green(int x,int y){return 30+y*17;}
+static unsigned char blue(int x,int y){return (x*7+y*11)*5;}
+
+static void madergb(int x,int y,unsigned char *rgb)
+{
+	rgb[0]=red(x,y);
+	rgb[1]=green(x,y);
+	rgb[2]=blue(x,y);
+}
+
+static void picrgb(int x,int y,unsigned char *rgb)
+{
+	qoipic(x,y,imgw,imgh,rgb);
+}
+
+static void makeqoi(int w,int h)
+{
+//横w*縦hの画像を、QOI_OP_RGBとQOI_OP_RGBA（アルファ値は様々）を交互に並べたQOI形式のデータにする
+	unsigned char *p;
+	int x,y,i;
+	p=qoi;
+	*p++='q';
+	*p++='o';
+	*p++='i';
+	*p++='f';
+	for(i=24;i>=0;i-=8) *p++=w>>i;
+	for(i=24;i>=0;i-=8) *p++=h>>i;
+	*p++=3;
+	*p++=0;
+	for(y=0;y<h;y++){
+		for(x=0;x<w;x++){
+			*p++=((x+y)&1)?0xff:0xfe;
+			*p++=red(x,y);
+			*p++=green(x,y);
+			*p++=blue(x,y);
+			if((x+y)&1) *p++=x*40+y;
+		}
+	}
+	for(i=0;i<7;i++) *p++=0;
+	*p++=1;
+	img=qoi;
+	imgw=w;
+	imgh=h;
+	imgrgb=madergb;
+}
+
+//QOIの符号の種類
+enum {OP_RGB,OP_RGBA,OP_INDEX,OP_DIFF,OP_LUMA,OP_RUN,OP_NUM};
+static const char *opname[OP_NUM]={"RGB","RGBA","INDEX","DIFF","LUMA","RUN"};
+
+static int countops(const unsigned char *p,int w,int h,int *ops)
+{
+//QOI形式のデータpの符号を種類ごとにopsに数え、行の境界をまたぐQOI_OP_RUNの数を返す
+	int i,n,cross;
+	unsigned char op;
+	for(i=0;i<OP_NUM;i++) ops[i]=0;
+	cross=0;
+	p+=14;
+	i=0;
+	while(i<w*h){
+		op=*p++;
+		n=1;
+		if(op==0xfe){
+			ops[OP_RGB]++;
+			p+=3;
+		}
+		else if(op==0xff){
+			ops[OP_RGBA]++;
+			p+=4;
+		}
+		else if((op>>6)==0) ops[OP_INDEX]++;
+		else if((op>>6)==1) ops[OP_DIFF]++;
+		else if((op>>6)==2){
+			ops[OP_LUMA]++;
+			p++;
+		}
+		else{
+			ops[OP_RUN]++;
+			n=(op&0x3f)+1;
+			if(i/w!=(i+n-1)/w) cross++;
+		}
+		i+=n;
+	}
+	return cross;
+}
+
+static void testqoi(int x0,int y0,int cx,int cy,int cw,int ch)
+{
+//画像imgを(x0,y0)に、(cx,cy)から横cw*縦chのクリッピング範囲で表示して検査
+	int x,y,w,h,bad,in;
+	unsigned char rgb[3];
+	unsigned int c;
+	w=imgw;
+	h=imgh;
+	LCD_Clear(BGCOLOR);
+	LCD_WaitDMA();
+	hostsim_reset();
+	pushclip(cx,cy,cw,ch);
+	putqoi(x0,y0,img);
+	popclip();
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_errors==0,"%dx%d: %d protocol errors",w,h,hostsim_errors);
+	bad=0;
+	for(y=y0-1;y<=y0+h;y++){
+		for(x=x0-1;x<=x0+w;x++){
+			if(x<0 || y<0 || x>=X_RES || y>=Y_RES) continue;
+			in=x>=x0 && x<x0+w && y>=y0 && y<y0+h && x>=cx && x<cx+cw && y>=cy && y<cy+ch;
+			if(in){
+				imgrgb(x-x0,y-y0,rgb);
+				c=hostsim_rgb(LCD_RGB(rgb[0],rgb[1],rgb[2]));
+			}
+			else c=hostsim_rgb(BGCOLOR);
+			bad+=(hostsim_pixel(x,y)!=c);
+		}
+	}
+	HOSTSIM_CHECK(bad==0,"%dx%d at %d,%d clip %d,%d %dx%d: %d pixels differ",w,h,x0,y0,cx,cy,cw,ch,bad);
+}
+
+static void testclips(void)
+{
+//画像imgを、そのまま、クリッピングした状態、画面の端からはみ出す位置で表示して検査
+	int w,h;
+	w=imgw;
+	h=imgh;
+	testqoi(10,20,0,0,X_RES,Y_RES);
+	//左上、右下を切り取って奇数・偶数の大きさにする
+	testqoi(10,20,11,21,X_RES,Y_RES);
+	testqoi(10,20,0,0,10+w-1,20+h-1);
+	testqoi(10,20,12,21,w-3,h-1);
+	//画面の端からはみ出す
+	testqoi(X_RES-w/2-1,Y_RES-h/2-1,0,0,X_RES,Y_RES);
+	testqoi(-w/2,-h/2,0,0,X_RES,Y_RES);
+}
+
+static void testpic(const unsigned char *p,int w,int h)
+{
+//tools/mkqoi.cで変換した検査用画像pを検査する
+	int ops[OP_NUM],i,cross;
+	img=p;
+	imgw=w;
+	imgh=h;
+	imgrgb=picrgb;
+	cross=countops(p,w,h,ops);
+	for(i=0;i<OP_NUM;i++){
+		if(i!=OP_RGBA) HOSTSIM_CHECK(ops[i]>0,"%dx%d: no QOI_OP_%s",w,h,opname[i]);
+	}
+	HOSTSIM_CHECK(cross>0,"%dx%d: no QOI_OP_RUN across a line boundary",w,h);
+	testclips();
+}
+
+int main(void)
+{
+	static const int size[][2]={{7,4},{7,3},{8,4},{8,3},{1,2},{1,1},{16,16},{15,16}};
+	int k,ops[OP_NUM];
+	spi_init(SPICH,40000000);
+	init_graphic();
+	for(k=0;k<(int)(sizeof(size)/sizeof(size[0]));k++){
+		makeqoi(size[k][0],size[k][1]);
+		countops(qoi,imgw,imgh,ops);
+		HOSTSIM_CHECK(ops[OP_RGBA]>0 || imgw*imgh<2,"%dx%d: no QOI_OP_RGBA",imgw,imgh);
+		testclips();
+	}
+	testpic(qoipic_40x24,40,24);
+	testpic(qoipic_37x23,37,23);
+	printf("test_qoi: %s\n",hostsim_fails?"FAILED":"ok");
+	return hostsim_fails!=0;
+}
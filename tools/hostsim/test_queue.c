@@ -0,0 +1,149 @@
+// トランザクションと転送キュー（LCD_TxBegin/End、LCD_TxQueue、LCD_TxDMA）の送信内容を検査する
+// キューに積んだデータが順序どおり1回のCSアサートの中で送られること、
+// DMA転送中のLCD_TxEnd()ではCSを解放せず次のトランザクションに引き継ぐことを確かめる
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "LCDdriver.h"
+#include "hostsim.h"
+
+#define SPI_BAUD 40000000
+#define QUEUE_BYTES 4000
+
+static unsigned char pattern(int i)
+{
+//送信するデータのi番目のバイト
+	return (unsigned char)(i*7+(i>>8));
+}
+
+static int checkdata(int from,int n,int start,const char *s)
+{
+//記録のfrom番目からnバイトがpattern(start)からのデータであること、次の位置を返す
+	int i,bad;
+	bad=0;
+	for(i=0;i<n && from+i<hostsim_loglen;i++){
+		if(hostsim_log[from+i].dc!=1 || hostsim_log[from+i].bits!=8 ||
+			hostsim_log[from+i].data!=pattern(start+i)) bad++;
+	}
+	HOSTSIM_CHECK(i==n,"%s: %d of %d bytes sent",s,i,n);
+	HOSTSIM_CHECK(bad==0,"%s: %d bytes differ",s,bad);
+	return from+n;
+}
+
+static void testqueue(void)
+{
+//キューのバッファ境界をまたぐ大きさで積み、直後に元のバッファを書き換える
+	static const int size[]={1,511,513,7,1024,300,1,700};
+	unsigned char b[1024];
+	int i,k,n,p;
+
+	hostsim_reset();
+	LCD_TxBegin();
+	LCD_TxComm(0x2c);
+	n=0;
+	for(k=0;n<QUEUE_BYTES;k++){
+		p=size[k%(sizeof(size)/sizeof(size[0]))];
+		if(p>QUEUE_BYTES-n) p=QUEUE_BYTES-n;
+		for(i=0;i<p;i++) b[i]=pattern(n+i);
+		LCD_TxQueue(b,p);
+		memset(b,0xee,p);
+		n+=p;
+	}
+	//キューに残ったデータの後にコマンドが送られること
+	LCD_TxComm(0x00);
+	LCD_TxEnd();
+	LCD_WaitDMA();
+
+	HOSTSIM_CHECK(hostsim_errors==0,"queue: %d protocol errors",hostsim_errors);
+	HOSTSIM_CHECK(hostsim_csfalls==1,"queue: %u CS assertions",hostsim_csfalls);
+	HOSTSIM_CHECK(hostsim_cs()==1,"queue: CS not released");
+	HOSTSIM_CHECK(hostsim_loglen==QUEUE_BYTES+2,"queue: %d frames sent",hostsim_loglen);
+	HOSTSIM_CHECK(hostsim_log[0].dc==0 && hostsim_log[0].data==0x2c,"queue: RAMWR not first");
+	p=checkdata(1,QUEUE_BYTES,0,"queue");
+	HOSTSIM_CHECK(p<hostsim_loglen && hostsim_log[p].dc==0 && hostsim_log[p].data==0x00,
+		"queue: command not after the queued data");
+	HOSTSIM_CHECK(hostsim_dmabits==QUEUE_BYTES*8,"queue: %llu bits sent by DMA",hostsim_dmabits);
+}
+
+static void testhandoff(void)
+{
+//DMA転送中にLCD_TxEnd()した場合、CSはアサートしたままで次のLCD_TxBegin()に引き継ぐ
+	unsigned char b[700];
+	int i;
+
+	for(i=0;i<(int)sizeof(b);i++) b[i]=pattern(i);
+	hostsim_reset();
+	LCD_TxBegin();
+	LCD_TxComm(0x2c);
+	LCD_TxQueue(b,600);
+	LCD_TxEnd();
+	HOSTSIM_CHECK(hostsim_dmabusy(),"handoff: transfer finished in LCD_TxEnd");
+	HOSTSIM_CHECK(hostsim_cs()==0,"handoff: CS released during the transfer");
+
+	LCD_TxBegin();
+	LCD_TxQueue(b+600,100);
+	LCD_TxEnd();
+	HOSTSIM_CHECK(hostsim_csfalls==1,"handoff: %u CS assertions",hostsim_csfalls);
+	HOSTSIM_CHECK(hostsim_cs()==0,"handoff: CS released during the transfer");
+
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_cs()==1,"handoff: CS not released after LCD_WaitDMA");
+	HOSTSIM_CHECK(hostsim_errors==0,"handoff: %d protocol errors",hostsim_errors);
+	HOSTSIM_CHECK(hostsim_loglen==701,"handoff: %d frames sent",hostsim_loglen);
+	checkdata(1,700,0,"handoff");
+	HOSTSIM_CHECK(hostsim_log[hostsim_loglen-1].cs==hostsim_log[0].cs,"handoff: CS toggled");
+
+	//次のトランザクションは新たにCSをアサートする
+	hostsim_reset();
+	LCD_TxBegin();
+	LCD_TxComm(0x00);
+	LCD_TxEnd();
+	HOSTSIM_CHECK(hostsim_csfalls==1 && hostsim_cs()==1,"handoff: CS not asserted again");
+}
+
+static void testdma(void)
+{
+//2つのバッファを交互にLCD_TxDMA()し、送信中に次のバッファを用意する
+	static unsigned char b[2][1000];
+	int i,k;
+
+	hostsim_reset();
+	LCD_TxBegin();
+	LCD_TxComm(0x2c);
+	for(k=0;k<6;k++){
+		for(i=0;i<1000;i++) b[k&1][i]=pattern(k*1000+i);
+		LCD_TxDMA(b[k&1],1000);
+		HOSTSIM_CHECK(hostsim_dmabusy(),"dma: LCD_TxDMA waited for its own transfer");
+	}
+	LCD_TxEnd();
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_errors==0,"dma: %d protocol errors",hostsim_errors);
+	HOSTSIM_CHECK(hostsim_csfalls==1,"dma: %u CS assertions",hostsim_csfalls);
+	HOSTSIM_CHECK(hostsim_loglen==6001,"dma: %d frames sent",hostsim_loglen);
+	checkdata(1,6000,0,"dma");
+
+	//送信中のバッファを書き換えると送信内容が変わる（模擬ハードウェアが検出できること）
+	hostsim_reset();
+	LCD_TxBegin();
+	LCD_TxComm(0x2c);
+	for(i=0;i<1000;i++) b[0][i]=pattern(i);
+	LCD_TxDMA(b[0],1000);
+	b[0][999]^=0xff;
+	LCD_TxEnd();
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_log[1000].data!=pattern(999),"dma: overwrite during the transfer not visible");
+}
+
+int main(void)
+{
+	spi_init(SPICH,SPI_BAUD);
+	LCD_Init();
+	LCD_WaitDMA();
+	testqueue();
+	testhandoff();
+	testdma();
+	printf("test_queue: %s\n",hostsim_fails?"FAILED":"ok");
+	return hostsim_fails!=0;
+}
@@ -0,0 +1,94 @@
+// 走査位置の推定（LCD_ScanDistance）と描画タイミングの調整（LCD_WaitScanOut）を検査する
+// 模擬ハードウェアの走査線と比べ、推定した走査位置が合っていること、
+// LCD_WaitScanOut()の後に描画すれば走査線上の画素に書き込まない（テアリングしない）ことを確かめる
+// LCD_TE（TE出力のGPIO）を設定したビルドと、設定せず表示オンの時刻から推定するビルドの両方で実行する
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "LCDdriver.h"
+#include "hostsim.h"
+
+#define SPI_BAUD 40000000
+#define TE_PHASE_US 3210 //TE出力がある場合の走査開始の位相（表示オンの時刻とは無関係な値）
+#define FILL_NUM 3000
+
+static unsigned int seed=12345;
+
+static unsigned int rnd(unsigned int n)
+{
+//0からn-1の乱数
+	seed=seed*1103515245+12345;
+	return (seed>>16)%n;
+}
+
+static void testdistance(unsigned short scroll)
+{
+//走査線が各ラインに到達するまでのライン数を、模擬ハードウェアの走査線と比べる
+	int i,y,d,s,e,bad;
+	LCD_SetScroll(scroll);
+	LCD_WaitDMA();
+	bad=0;
+	for(i=0;i<1000;i++){
+		hostsim_wait_ns(rnd(LCD_FRAME_US)*1000ull);
+		y=rnd(LCD_GRAMH);
+		d=LCD_ScanDistance(0,y);
+		s=hostsim_scanline();
+		//メモリのy行目は表示上の(y-scroll)ライン
+		e=((y+LCD_GRAMH-scroll)%LCD_GRAMH+LCD_GRAMH-s)%LCD_GRAMH;
+		//時刻の丸めで1ラインまでの誤差は許す
+		e=(d-e+LCD_GRAMH)%LCD_GRAMH;
+		if(e>1 && e<LCD_GRAMH-1) bad++;
+	}
+	HOSTSIM_CHECK(bad==0,"scroll %d: %d of 1000 scan distances wrong",scroll,bad);
+}
+
+static unsigned int filltest(int wait)
+{
+//セル程度の大きさの範囲をランダムな位置とタイミングで塗りつぶし、テアリングした画素数を返す
+//wait:描画前にLCD_WaitScanOut()を呼ぶ
+	int i,x,y,w,h;
+	hostsim_reset();
+	for(i=0;i<FILL_NUM;i++){
+		hostsim_wait_ns(rnd(LCD_FRAME_US)*1000ull);
+		w=8+rnd(57);
+		h=1+rnd(16);
+		x=rnd(X_RES-w+1);
+		y=rnd(Y_RES-h+1);
+		if(wait) LCD_WaitScanOut(x,y,w,h);
+		LCD_Fill(x,y,w,h,(unsigned short)i);
+	}
+	LCD_WaitDMA();
+	HOSTSIM_CHECK(hostsim_errors==0,"%d protocol errors",hostsim_errors);
+	return hostsim_tears;
+}
+
+int main(void)
+{
+	unsigned int tears;
+	spi_init(SPICH,SPI_BAUD);
+#if LCD_TE >= 0
+	//走査開始の時刻はTE出力の割り込みで知る
+	hostsim_te(LCD_FRAME_US,TE_PHASE_US);
+#endif
+	LCD_Init();
+	LCD_WaitDMA();
+#if LCD_TE >= 0
+	//最初のTE出力の割り込みまでは表示オンの時刻から推定するため、1フレーム待ってから検査する
+	hostsim_wait_ns(LCD_FRAME_US*1000ull);
+#endif
+
+	testdistance(0);
+	testdistance(100);
+	LCD_SetScroll(0);
+
+	//同期しない場合にテアリングが起きること（検査が有効であること）を確かめる
+	tears=filltest(0);
+	HOSTSIM_CHECK(tears>0,"no tearing detected without LCD_WaitScanOut");
+	printf("without LCD_WaitScanOut: %u pixels torn\n",tears);
+	tears=filltest(1);
+	HOSTSIM_CHECK(tears==0,"%u pixels torn after LCD_WaitScanOut",tears);
+
+	printf("test_te (LCD_TE=%d): %s\n",LCD_TE,hostsim_fails?"FAILED":"ok");
+	return hostsim_fails!=0;
+}
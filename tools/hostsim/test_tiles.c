@@ -0,0 +1,48 @@
+// タイルマップのパレットアニメーション（changepalette、animpalette）を検査する
+// 色を変えたカラー番号を使っているセルが、文字番号によらず再描画されることを確かめる
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "LCDdriver.h"
+#include "graphlib.h"
+#include "hostsim.h"
+
+extern unsigned short palette[256];
+extern const unsigned char FontData[];
+
+static void testpalette(unsigned char n)
+{
+//文字番号nのセルの文字色を変更し、再描画後に文字の点が新しい色になっていること
+	int x,y;
+	unsigned char d;
+	cleartiles(0);
+	set_palette(5,255,0,0);
+	puttile(1,1,5,0,n);
+	flushtiles();
+	//文字の最初の点を探す
+	for(y=0;y<8;y++){
+		d=FontData[n*8+y];
+		if(d) break;
+	}
+	for(x=0;(d&0x80)==0;x++) d<<=1;
+	x=FONTSIZE+x*LCD_SCALE;
+	y=FONTSIZE+y*LCD_SCALE;
+	HOSTSIM_CHECK(hostsim_pixel(x,y)==hostsim_rgb(palette[5]),"glyph %d: not drawn",n);
+
+	changepalette(5,0,255,0);
+	while(animpalette(64)) flushtiles();
+	flushtiles();
+	HOSTSIM_CHECK(hostsim_pixel(x,y)==hostsim_rgb(palette[5]),"glyph %d: not redrawn after changepalette",n);
+}
+
+int main(void)
+{
+	spi_init(SPICH,40000000);
+	init_graphic();
+	inittiles(0,0);
+	testpalette('A');
+	testpalette(0xff);
+	printf("test_tiles: %s\n",hostsim_fails?"FAILED":"ok");
+	return hostsim_fails!=0;
+}
@@ -0,0 +1,70 @@
+// フォントの点の並びを長方形の塗りつぶし範囲の表に変換するツール
+// 背景色なしの文字表示で、長方形ごとに1回の塗りつぶしで描画するために使う
+// ホストPC用。tetrisfont.cを変更した場合は以下で作り直す
+//   cc -o mkfontspan tools/mkfontspan.c tetrisfont.c
+//   ./mkfontspan > fontspan.c
+
+#include <stdio.h>
+
+extern const unsigned char FontData[256*8];
+
+int main(void){
+	int n,x,y,x2,y2,len,h,count,col;
+	unsigned char done[8];
+	unsigned short index[257];
+
+	printf("//フォントの点の並びを長方形に分けた表（tools/mkfontspan.cで生成）\n");
+	printf("//文字nの長方形はFontSpan[FontSpanIndex[n]]からFontSpan[FontSpanIndex[n+1]-1]まで\n");
+	printf("//1つの長方形を2バイトで表す。1バイト目:上位4ビットがy、下位4ビットが高さ-1\n");
+	printf("//2バイト目:上位4ビットがx、下位4ビットが幅-1\n\n");
+	printf("const unsigned char FontSpan[]={\n");
+	count=0;
+	for(n=0;n<256;n++){
+		index[n]=count;
+		for(y=0;y<8;y++) done[y]=0;
+		col=0;
+		for(y=0;y<8;y++){
+			for(x=0;x<8;){
+				if(!(FontData[n*8+y]&(0x80>>x)) || (done[y]&(0x80>>x))){
+					x++;
+					continue;
+				}
+				//横に連続する点
+				for(len=1;x+len<8 && (FontData[n*8+y]&(0x80>>(x+len))) && !(done[y]&(0x80>>(x+len)));len++) ;
+				//下の行に同じ範囲の点が並ぶ限り縦に広げる
+				for(h=1;y+h<8;h++){
+					for(x2=x;x2<x+len;x2++){
+						if(!(FontData[(n*8)+y+h]&(0x80>>x2)) || (done[y+h]&(0x80>>x2))) break;
+					}
+					if(x2<x+len) break;
+					//広げた行で範囲の左右にも点が続く場合は、その行の横の並びを分断しないよう止める
+					if((x>0 && (FontData[n*8+y+h]&(0x80>>(x-1))) && !(done[y+h]&(0x80>>(x-1))))
+						|| (x+len<8 && (FontData[n*8+y+h]&(0x80>>(x+len))) && !(done[y+h]&(0x80>>(x+len))))) break;
+				}
+				for(y2=y;y2<y+h;y2++){
+					for(x2=x;x2<x+len;x2++) done[y2]|=0x80>>x2;
+				}
+				if(col==0) printf("\t");
+				printf("0x%02X,0x%02X,",(y<<4)|(h-1),(x<<4)|(len-1));
+				if(++col==6){
+					printf(" //0x%02X\n",n);
+					col=0;
+				}
+				count++;
+				x+=len;
+			}
+		}
+		if(col) printf(" //0x%02X\n",n);
+	}
+	index[256]=count;
+	printf("};\n\n");
+	printf("const unsigned short FontSpanIndex[257]={\n");
+	for(n=0;n<257;n++){
+		if(n%16==0) printf("\t");
+		printf("%d,",index[n]*2);
+		if(n%16==15 || n==256) printf("\n");
+	}
+	printf("};\n");
+	fprintf(stderr,"%d spans\n",count);
+	return 0;
+}
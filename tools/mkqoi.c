@@ -0,0 +1,152 @@
+// putqoi()用のフルカラー画像データを作るツール
+// ホストPC用。バイナリ形式のPPM画像（P6、各色8ビット）を標準入力から読み、
+// QOI形式（https://qoiformat.org/）のC言語の配列を標準出力に書き出す
+//   cc -o mkqoi tools/mkqoi.c
+//   ./mkqoi name < image.ppm > image.c
+// 他の形式の画像は、例えばImageMagickで convert image.png image.ppm として変換しておく
+
+// QOI形式
+//  14バイトのヘッダ（"qoif"、横幅と縦幅のビッグエンディアン32ビット、チャンネル数3、色空間0）
+//  以降、左上の画素から順に以下のいずれかを並べ、最後に7バイトの0と1バイトの1を置く
+//   0xFE r g b           : 画素の値
+//   00iiiiii             : 最近の画素の表の番号iの画素
+//   01rrggbb             : 直前の画素との差（各色-2〜1）
+//   10gggggg rrrrbbbb    : 直前の画素との差（緑-32〜31、赤と青は緑の差との差-8〜7）
+//   11nnnnnn             : 直前の画素がn+1個続く（n=0〜61）
+//  表の番号は (r*3+g*5+b*7+255*11)%64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+static unsigned char *out;
+static int outlen;
+
+static void put(int d)
+{
+	out[outlen++]=d;
+}
+
+static void put32(unsigned int d)
+{
+	put(d>>24);
+	put(d>>16);
+	put(d>>8);
+	put(d);
+}
+
+static int ppmnum(void)
+{
+	// PPMヘッダの数値を1つ読む（#から行末まではコメント）
+	int c,n;
+	while(1){
+		c=getchar();
+		if(c=='#'){
+			while(c!='\n' && c!=EOF) c=getchar();
+		}
+		else if(!isspace(c)) break;
+	}
+	if(!isdigit(c)) return -1;
+	for(n=0;isdigit(c);c=getchar()) n=n*10+c-'0';
+	return n;
+}
+
+int main(int argc,char *argv[]){
+	int m,n,i,k,run,maxval;
+	int r,g,b,pr,pg,pb,dr,dg,db,dr_dg,db_dg;
+	unsigned char *img;
+	int index[64][3];
+	if(argc<2){
+		fprintf(stderr,"usage: mkqoi name < image.ppm > out.c\n");
+		return 1;
+	}
+	if(getchar()!='P' || getchar()!='6'){
+		fprintf(stderr,"input must be binary PPM (P6)\n");
+		return 1;
+	}
+	m=ppmnum();
+	n=ppmnum();
+	maxval=ppmnum();
+	if(m<1 || n<1 || maxval!=255){
+		fprintf(stderr,"bad PPM header (8-bit P6 only)\n");
+		return 1;
+	}
+	img=malloc(m*n*3);
+	if(fread(img,3,m*n,stdin)!=(size_t)(m*n)){
+		fprintf(stderr,"too few data\n");
+		return 1;
+	}
+	out=malloc(14+m*n*4+8);
+
+	put('q');
+	put('o');
+	put('i');
+	put('f');
+	put32(m);
+	put32(n);
+	put(3);
+	put(0);
+	//表の初期値はアルファ値0の画素なので、不透明の画素とは一致させない
+	for(i=0;i<64;i++) index[i][0]=index[i][1]=index[i][2]=-1;
+	pr=pg=pb=0;
+	run=0;
+	for(i=0;i<m*n;i++){
+		r=img[i*3];
+		g=img[i*3+1];
+		b=img[i*3+2];
+		if(r==pr && g==pg && b==pb){
+			//同じ画素の並び
+			if(++run==62){
+				put(0xc0|(run-1));
+				run=0;
+			}
+			continue;
+		}
+		if(run){
+			put(0xc0|(run-1));
+			run=0;
+		}
+		k=(r*3+g*5+b*7+255*11)%64;
+		if(index[k][0]==r && index[k][1]==g && index[k][2]==b) put(k);
+		else{
+			index[k][0]=r;
+			index[k][1]=g;
+			index[k][2]=b;
+			dr=(signed char)(r-pr);
+			dg=(signed char)(g-pg);
+			db=(signed char)(b-pb);
+			dr_dg=dr-dg;
+			db_dg=db-dg;
+			if(dr>=-2 && dr<=1 && dg>=-2 && dg<=1 && db>=-2 && db<=1){
+				put(0x40|((dr+2)<<4)|((dg+2)<<2)|(db+2));
+			}
+			else if(dg>=-32 && dg<=31 && dr_dg>=-8 && dr_dg<=7 && db_dg>=-8 && db_dg<=7){
+				put(0x80|(dg+32));
+				put(((dr_dg+8)<<4)|(db_dg+8));
+			}
+			else{
+				put(0xfe);
+				put(r);
+				put(g);
+				put(b);
+			}
+		}
+		pr=r;
+		pg=g;
+		pb=b;
+	}
+	if(run) put(0xc0|(run-1));
+	for(i=0;i<7;i++) put(0);
+	put(1);
+
+	printf("//%s: %dx%d QOI (tools/mkqoi.c)\n",argv[1],m,n);
+	printf("const unsigned char %s[%d]={\n",argv[1],outlen);
+	for(i=0;i<outlen;i++){
+		if(i%16==0) printf("\t");
+		printf("0x%02X,",out[i]);
+		if(i%16==15 || i==outlen-1) printf("\n");
+	}
+	printf("};\n");
+	fprintf(stderr,"%d bytes (raw %d bytes)\n",outlen,m*n*3);
+	return 0;
+}
@@ -0,0 +1,103 @@
+// putrle()用のスプライトデータを作るツール
+// ホストPC用。横m*縦nドットのカラー番号の並び（putbmpmn()に渡す配列と同じ内容）を
+// 標準入力から読み、RLE形式のC言語の配列を標準出力に書き出す
+//   cc -o mkrle tools/mkrle.c
+//   ./mkrle name m n < sprite.txt > sprite.c
+// 入力は数値（10進または0x付き16進）を空白やカンマで区切って並べたもの。カラー番号0は透明
+
+// RLE形式
+//  1バイト目:横幅m、2バイト目:縦幅n
+//  以降、各行ごとに以下を繰り返す
+//   透明の画素数（0〜255）
+//   不透明の画素数k（1〜127）とカラー番号k個
+//   または、不透明の画素数k+0x80（k=1〜127）と1つのカラー番号（同じ色がk画素続く）
+//  不透明の画素数の代わりに0を置くと、その行の終わり
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#define SOLIDMIN 3 //同じ色がこの画素数以上続く場合は塗りつぶしとして符号化する
+
+static unsigned char out[65536*2];
+static int outlen;
+
+static void put(int d)
+{
+	out[outlen++]=d;
+}
+
+int main(int argc,char *argv[]){
+	int m,n,x,y,i,k,c,len;
+	unsigned char *bmp;
+	if(argc<4){
+		fprintf(stderr,"usage: mkrle name width height < data > out.c\n");
+		return 1;
+	}
+	m=atoi(argv[2]);
+	n=atoi(argv[3]);
+	if(m<1 || m>255 || n<1 || n>255){
+		fprintf(stderr,"width and height must be 1-255\n");
+		return 1;
+	}
+	bmp=malloc(m*n);
+	for(i=0;i<m*n;i++){
+		do c=getchar(); while(c!=EOF && !isxdigit(c));
+		if(c==EOF){
+			fprintf(stderr,"too few data (%d/%d)\n",i,m*n);
+			return 1;
+		}
+		ungetc(c,stdin);
+		if(scanf("%i",&k)!=1 || k<0 || k>255){
+			fprintf(stderr,"bad data at %d\n",i);
+			return 1;
+		}
+		bmp[i]=k;
+	}
+
+	put(m);
+	put(n);
+	for(y=0;y<n;y++){
+		x=0;
+		while(1){
+			for(k=0;x+k<m && bmp[y*m+x+k]==0 && k<255;k++) ;
+			if(x+k>=m){
+				//行の残りは全て透明
+				put(k);
+				put(0);
+				break;
+			}
+			put(k);
+			x+=k;
+			//同じ色が続く場合は塗りつぶし
+			c=bmp[y*m+x];
+			for(len=1;x+len<m && bmp[y*m+x+len]==c && len<127;len++) ;
+			if(len>=SOLIDMIN){
+				put(len|0x80);
+				put(c);
+				x+=len;
+				continue;
+			}
+			//透明画素、または同じ色がSOLIDMIN画素以上続く位置までを1つの並びにする
+			for(len=0;x+len<m && bmp[y*m+x+len]!=0 && len<127;len++){
+				c=bmp[y*m+x+len];
+				for(k=1;x+len+k<m && bmp[y*m+x+len+k]==c && k<SOLIDMIN;k++) ;
+				if(k>=SOLIDMIN && len>0) break;
+			}
+			put(len);
+			for(i=0;i<len;i++) put(bmp[y*m+x+i]);
+			x+=len;
+		}
+	}
+
+	printf("//%s: %dx%d RLE (tools/mkrle.c)\n",argv[1],m,n);
+	printf("const unsigned char %s[%d]={\n",argv[1],outlen);
+	for(i=0;i<outlen;i++){
+		if(i%16==0) printf("\t");
+		printf("0x%02X,",out[i]);
+		if(i%16==15 || i==outlen-1) printf("\n");
+	}
+	printf("};\n");
+	fprintf(stderr,"%d bytes (raw %d bytes)\n",outlen,m*n);
+	return 0;
+}
@@ -0,0 +1,151 @@
+// 画面レイアウト（タイトル画面、ゲーム画面）をタイルマップに変換するツール
+// レイアウトを描画手順の表で記述し、結果の文字番号とカラー番号の並びをC言語の配列として書き出す
+// ホストPC用。レイアウトを変更した場合は以下で作り直す
+//   cc -o mkscene tools/mkscene.c
+//   ./mkscene > scenes.c
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../tetris.h"
+
+//背景画像コード 横24×縦14キャラクター
+static const unsigned char bitmap1[]={
+	0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x62,0x20,0x20,0x20,0x20,
+	0x20,0x20,0x20,0x20,0x20,0x20,0x63,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x20,0x20,0x20,0x20,
+	0x20,0x20,0x20,0x20,0x20,0x20,0x65,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x20,0x20,0x20,0x20,
+	0x20,0x20,0x20,0x20,0x20,0x67,0x68,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6a,0x20,0x20,0x20,0x20,
+	0x20,0x20,0x20,0x20,0x20,0x6b,0x6c,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6e,0x6f,0x20,0x20,0x20,
+	0x20,0x20,0x20,0x20,0x20,0x70,0x71,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x72,0x73,0x74,0x75,0x76,0x20,0x20,
+	0x20,0x20,0x20,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x7e,0x7f,0x80,0x81,0x82,0x20,0x20,
+	0x20,0x20,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x20,0x20,0x20,0x20,0x20,0x20,0x8b,0x8c,0x8d,0x20,0x8e,0x8f,0x90,0x20,
+	0x20,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x20,0x20,0x20,0x20,0x20,0x20,0x9a,0x9b,0x9c,0x20,0x9d,0x9e,0x20,0x20,
+	0x20,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0x20,0x20,0x20,0x20,0x20,0xa9,0xaa,0xab,0xac,0xad,0xae,0x20,0x20,
+	0xaf,0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0x20,0x20,0x20,0x20,0x20,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0x20,0x20,
+	0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0x20,0x20,0x20,0x20,0x20,0xcb,0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0x20,
+	0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0x20,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,
+	0xe9,0xea,0xeb,0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0x20,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff
+};
+
+//描画手順
+enum {
+	SC_END, //終わり
+	SC_FILL, //x,yから横w*縦hをカラー番号cの文字番号nで埋める
+	SC_TEXT, //x,yからカラー番号cで文字列pを書く
+	SC_MAP, //x,yから横w*縦hにカラー番号cで文字番号の配列p（1行strideバイト）を並べる
+	SC_FRAME //x,yから横w*縦hの枠をカラー番号cで描き、内側を空白にする
+};
+typedef struct {
+	unsigned char op;
+	unsigned char x,y,w,h;
+	unsigned char c,n;
+	const unsigned char *p;
+	int stride;
+} _Sceneop;
+
+#define TEXT(x,y,c,s) {SC_TEXT,x,y,0,0,c,0,(const unsigned char *)(s),0}
+
+//タイトル画面
+static const _Sceneop title[]={
+	{SC_MAP,3,3,24,14,COLOR_BITMAP,0,bitmap1,24}, //背景画像
+	{SC_MAP,10,4,10,2,4,0,(const unsigned char *)"\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13"
+		"\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d",10}, //タイトルロゴ
+	TEXT(5,0,5,"SCORE"),
+	TEXT(18,0,5,"HI-SCORE"),
+	TEXT(3,19,5,"LEFT   \x5c"),
+	TEXT(3,20,5,"RIGHT  \x5b"),
+	TEXT(3,21,5,"ROTATE \x1e"),
+	TEXT(3,22,5,"DOWN   \x1f"),
+	TEXT(17,19,7,"TETRIS"),
+	TEXT(19,20,7,"FOR"),
+	TEXT(15,21,7,"RASPBERRY PI"),
+	TEXT(18,22,7,"PICO"),
+	TEXT(17,23,7,"\x5eKENKEN"),
+	TEXT(6,25,6,"PUSH START BUTTON"),
+	{SC_END}
+};
+
+//ゲーム画面
+static const _Sceneop game[]={
+	{SC_FILL,0,15,30,12,COLOR_BRICK,CODE_BRICK}, //下側のレンガ
+	{SC_MAP,0,0,11,14,COLOR_BITMAP,0,bitmap1,24}, //背景画像の左側
+	{SC_MAP,23,0,7,14,COLOR_BITMAP,0,bitmap1+16,24}, //背景画像の右側
+	{SC_FRAME,0,14,10,13,COLOR_FRAME}, //得点表示枠
+	TEXT(2,15,7,"SCORE"),
+	TEXT(1,18,7,"HI-SCORE"),
+	TEXT(2,21,7,"LINES"),
+	TEXT(2,24,7,"LEVEL"),
+	{SC_FRAME,24,16,6,8,COLOR_FRAME}, //NEXT表示枠
+	TEXT(25,18,7,"NEXT"),
+	{SC_FILL,11,0,12,25,COLOR_WALL,CODE_WALL}, //壁
+	{SC_FILL,12,1,10,23,0,0}, //ブロックが落下する範囲
+	{SC_END}
+};
+
+static unsigned char map[SCENE_H][SCENE_W][2]; //文字番号、カラー番号
+
+static void put(int x,int y,int c,int n)
+{
+	if(x<0 || x>=SCENE_W || y<0 || y>=SCENE_H) return;
+	map[y][x][0]=n;
+	map[y][x][1]=c;
+}
+
+static void fill(int x,int y,int w,int h,int c,int n)
+{
+	int i,j;
+	for(i=y;i<y+h;i++){
+		for(j=x;j<x+w;j++) put(j,i,c,n);
+	}
+}
+
+static void scene(const char *name,const _Sceneop *op)
+{
+	int i,j;
+	const unsigned char *p;
+	for(i=0;i<SCENE_H;i++){
+		for(j=0;j<SCENE_W;j++) put(j,i,0,0);
+	}
+	for(;op->op!=SC_END;op++){
+		switch(op->op){
+		case SC_FILL:
+			fill(op->x,op->y,op->w,op->h,op->c,op->n);
+			break;
+		case SC_TEXT:
+			for(p=op->p,j=op->x;*p;p++,j++) put(j,op->y,op->c,*p);
+			break;
+		case SC_MAP:
+			for(i=0;i<op->h;i++){
+				for(j=0;j<op->w;j++) put(op->x+j,op->y+i,op->c,op->p[i*op->stride+j]);
+			}
+			break;
+		case SC_FRAME:
+			fill(op->x,op->y,op->w,op->h,0,0);
+			fill(op->x+1,op->y,op->w-2,1,op->c,0x07);
+			fill(op->x+1,op->y+op->h-1,op->w-2,1,op->c,0x07);
+			fill(op->x,op->y+1,1,op->h-2,op->c,0x05);
+			fill(op->x+op->w-1,op->y+1,1,op->h-2,op->c,0x05);
+			put(op->x,op->y,op->c,0x04);
+			put(op->x+op->w-1,op->y,op->c,0x08);
+			put(op->x,op->y+op->h-1,op->c,0x06);
+			put(op->x+op->w-1,op->y+op->h-1,op->c,0x09);
+			break;
+		}
+	}
+	printf("const unsigned char %s[SCENE_H*SCENE_W*2]={\n",name);
+	for(i=0;i<SCENE_H;i++){
+		printf("\t");
+		for(j=0;j<SCENE_W;j++) printf("0x%02X,%d,",map[i][j][0],map[i][j][1]);
+		printf("\n");
+	}
+	printf("};\n\n");
+}
+
+int main(void){
+	printf("//画面レイアウトのタイルマップ（tools/mkscene.cで生成）\n");
+	printf("//横SCENE_W*縦SCENE_Hセル、1セルを2バイトで表す。1バイト目:文字番号、2バイト目:カラー番号\n\n");
+	printf("#include <stdint.h>\n");
+	printf("#include \"tetris.h\"\n\n");
+	scene("SceneTitle",title);
+	scene("SceneGame",game);
+	return 0;
+}